@@ -0,0 +1,75 @@
+/**
+ * @file DrawUnits.cpp
+ * @brief Runtime control over LVGL's software draw units
+ */
+
+#include "DrawUnits.h"
+#include "lvgl/lvgl.h"
+#include "lvgl/src/lvgl_private.h" /* lv_draw_unit_t and the global draw unit list */
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+struct SwUnit {
+    lv_draw_unit_t* unit;
+    int32_t (*dispatch)(lv_draw_unit_t* draw_unit, lv_layer_t* layer);
+};
+
+/** Dispatcher of a disabled unit: never takes a task */
+int32_t idleDispatch(lv_draw_unit_t* draw_unit, lv_layer_t* layer) {
+    (void)draw_unit;
+    (void)layer;
+    return LV_DRAW_UNIT_IDLE;
+}
+
+uint32_t activeCount = 0;
+
+/**
+ * The software units, in creation order. lv_init() creates them before any
+ * other draw unit and new units are added at the head of the list, so they
+ * are the units sharing the dispatcher of the last one.
+ */
+std::vector<SwUnit>& swUnits() {
+    static std::vector<SwUnit> units;
+    if (units.empty()) {
+        lv_draw_unit_t* last = NULL;
+        for (lv_draw_unit_t* u = LV_GLOBAL_DEFAULT()->draw_info.unit_head; u; u = u->next) {
+            last = u;
+        }
+        for (lv_draw_unit_t* u = LV_GLOBAL_DEFAULT()->draw_info.unit_head; u && last; u = u->next) {
+            if (u->dispatch_cb == last->dispatch_cb) {
+                units.push_back(SwUnit{u, u->dispatch_cb});
+            }
+        }
+        std::reverse(units.begin(), units.end());
+        activeCount = static_cast<uint32_t>(units.size());
+    }
+    return units;
+}
+
+} // namespace
+
+uint32_t DrawUnits::available() {
+    return static_cast<uint32_t>(swUnits().size());
+}
+
+uint32_t DrawUnits::active() {
+    swUnits();
+    return activeCount;
+}
+
+uint32_t DrawUnits::setActive(uint32_t count) {
+    std::vector<SwUnit>& units = swUnits();
+    if (units.empty()) {
+        return 0;
+    }
+    if (count == 0 || count > units.size()) {
+        count = static_cast<uint32_t>(units.size());
+    }
+    for (size_t i = 0; i < units.size(); ++i) {
+        units[i].unit->dispatch_cb = i < count ? units[i].dispatch : idleDispatch;
+    }
+    activeCount = count;
+    return count;
+}
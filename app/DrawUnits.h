@@ -0,0 +1,38 @@
+/**
+ * @file DrawUnits.h
+ * @brief Runtime control over LVGL's software draw units
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Select how many of the compiled software draw units render
+ *
+ * LVGL creates LV_DRAW_SW_DRAW_UNIT_CNT software draw units, one render
+ * thread each, inside lv_init(). The count is fixed at build time; this
+ * class lets the application use fewer of them, e.g. from a command line
+ * flag, without rebuilding. Units beyond the active count stop taking
+ * draw tasks and their threads stay asleep.
+ *
+ * Call after lv_init() and only between frames.
+ */
+class DrawUnits {
+public:
+    /**
+     * @brief Number of software draw units compiled in
+     */
+    static uint32_t available();
+
+    /**
+     * @brief Number of units currently taking draw tasks
+     */
+    static uint32_t active();
+
+    /**
+     * @brief Let the first count units render, 0 means all of them
+     * @return The count actually applied, clamped to [1, available()]
+     */
+    static uint32_t setActive(uint32_t count);
+};
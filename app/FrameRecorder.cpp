@@ -0,0 +1,120 @@
+/**
+ * @file FrameRecorder.cpp
+ * @brief Per-frame timing history with percentile export
+ */
+
+#include "FrameRecorder.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+FrameRecorder::FrameRecorder(uint32_t capacity) : mask_(0), head_(0) {
+    uint32_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots_.reset(new Slot[size]);
+    mask_ = size - 1;
+}
+
+void FrameRecorder::record(const FrameSample& sample) {
+    uint64_t index = head_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[index & mask_];
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sample = sample;
+    slot.sample.index = index;
+    slot.seq.store(seq + 2, std::memory_order_release);
+    head_.store(index + 1, std::memory_order_release);
+}
+
+uint64_t FrameRecorder::recorded() const {
+    return head_.load(std::memory_order_acquire);
+}
+
+uint32_t FrameRecorder::capacity() const {
+    return mask_ + 1;
+}
+
+bool FrameRecorder::read(uint64_t index, FrameSample& out) const {
+    const Slot& slot = slots_[index & mask_];
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        out = slot.sample;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == before) {
+            // Already overwritten by a newer frame counts as lost
+            return out.index == index;
+        }
+    }
+    return false;
+}
+
+std::vector<FrameSample> FrameRecorder::snapshot() const {
+    uint64_t head = recorded();
+    uint64_t first = head > capacity() ? head - capacity() : 0;
+    std::vector<FrameSample> samples;
+    samples.reserve(static_cast<size_t>(head - first));
+    FrameSample sample;
+    for (uint64_t i = first; i < head; ++i) {
+        if (read(i, sample)) {
+            samples.push_back(sample);
+        }
+    }
+    return samples;
+}
+
+namespace {
+
+uint32_t percentile(const std::vector<uint32_t>& sorted, uint32_t p) {
+    // Nearest rank
+    size_t rank = (sorted.size() * p + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+template <typename Field>
+void appendMetric(std::ostringstream& json, const char* name, const std::vector<FrameSample>& samples,
+                  Field field) {
+    std::vector<uint32_t> values;
+    values.reserve(samples.size());
+    for (const FrameSample& sample : samples) {
+        values.push_back(sample.*field);
+    }
+    std::sort(values.begin(), values.end());
+    json << ",\"" << name << "\":{";
+    if (!values.empty()) {
+        json << "\"p50\":" << percentile(values, 50) << ",\"p95\":" << percentile(values, 95)
+             << ",\"p99\":" << percentile(values, 99) << ",\"max\":" << values.back();
+    }
+    json << "}";
+}
+
+} // namespace
+
+std::string FrameRecorder::toJson() const {
+    std::vector<FrameSample> samples = snapshot();
+    std::ostringstream json;
+    json << "{\"frames\":" << samples.size() << ",\"recorded\":" << recorded();
+    appendMetric(json, "timerUs", samples, &FrameSample::timerUs);
+    appendMetric(json, "layoutUs", samples, &FrameSample::layoutUs);
+    appendMetric(json, "drawUs", samples, &FrameSample::drawUs);
+    appendMetric(json, "flushUs", samples, &FrameSample::flushUs);
+    appendMetric(json, "totalUs", samples, &FrameSample::totalUs);
+    appendMetric(json, "areas", samples, &FrameSample::areas);
+    appendMetric(json, "pixels", samples, &FrameSample::pixels);
+    json << "}";
+    return json.str();
+}
+
+bool FrameRecorder::writeJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << toJson() << '\n';
+    return static_cast<bool>(file);
+}
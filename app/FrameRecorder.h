@@ -0,0 +1,87 @@
+/**
+ * @file FrameRecorder.h
+ * @brief Per-frame timing history with percentile export
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Cost breakdown of one refresh
+ */
+struct FrameSample {
+    uint64_t index = 0;        /**< Sequence number of the frame since startup */
+    uint32_t timerUs = 0;      /**< Other LVGL timers run in the same lv_timer_handler pass (input, animations) */
+    uint32_t layoutUs = 0;     /**< Refresh start to render start: modifier flush and layout */
+    uint32_t drawUs = 0;       /**< Rendering the invalidated areas, flush excluded */
+    uint32_t flushUs = 0;      /**< Flush callbacks, waiting for them included */
+    uint32_t totalUs = 0;      /**< Refresh start to refresh ready */
+    uint32_t areas = 0;        /**< Invalidated areas after joining */
+    uint32_t pixels = 0;       /**< Pixels of those areas, i.e. redrawn */
+};
+
+/**
+ * @brief Fixed-size ring of the last frames
+ *
+ * The UI thread records one sample per rendered frame without locking or
+ * allocating; any thread can take a snapshot or export percentiles at the
+ * same time. Each slot carries a sequence counter, a reader retries or
+ * skips a slot the writer is overwriting while it is copied.
+ */
+class FrameRecorder {
+public:
+    /**
+     * @param capacity Frames kept, rounded up to a power of two
+     */
+    explicit FrameRecorder(uint32_t capacity = 1024);
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /**
+     * @brief Append a frame, UI thread only
+     */
+    void record(const FrameSample& sample);
+
+    /**
+     * @brief Frames recorded since startup, including those already overwritten
+     */
+    uint64_t recorded() const;
+
+    uint32_t capacity() const;
+
+    /**
+     * @brief Copy of the frames still in the ring, oldest first
+     */
+    std::vector<FrameSample> snapshot() const;
+
+    /**
+     * @brief Percentiles of every metric over the frames in the ring, as JSON
+     *
+     * {"frames":N,"recorded":M,"totalUs":{"p50":..,"p95":..,"p99":..,"max":..}, ...}
+     */
+    std::string toJson() const;
+
+    /**
+     * @brief Write toJson() to a file
+     * @return false if the file could not be written
+     */
+    bool writeJson(const std::string& path) const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq{0};  /**< Odd while the writer is inside */
+        FrameSample sample;
+    };
+
+    bool read(uint64_t index, FrameSample& out) const;
+
+    std::unique_ptr<Slot[]> slots_;
+    uint32_t mask_;
+    std::atomic<uint64_t> head_;     /**< Next frame to write */
+};
@@ -0,0 +1,909 @@
+/**
+ * @file LVGLApplication.cpp
+ * @brief C++ wrapper around LVGL initialization and the main loop
+ */
+
+#include "LVGLApplication.h"
+#include "DrawUnits.h"
+#include "lvgl/src/lvgl_private.h" /* invalidated areas of the display */
+#include LV_SDL_INCLUDE_PATH
+#include "lvgl/demos/lv_demos.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+/**
+ * Copy an area into a native (XRGB8888) frame, converting the pixels.
+ * src points at the area's first pixel, with srcStride bytes per line.
+ */
+void copyToNative(const lv_area_t& area, const uint8_t* src, uint32_t srcStride, lv_color_format_t srcFormat,
+                  uint8_t* frame, uint32_t frameStride) {
+    int32_t w = lv_area_get_width(&area);
+    for (int32_t y = area.y1; y <= area.y2; ++y, src += srcStride) {
+        uint8_t* dst = frame + y * frameStride + area.x1 * 4;
+        switch (srcFormat) {
+        case LV_COLOR_FORMAT_RGB565: {
+            const uint16_t* px = reinterpret_cast<const uint16_t*>(src);
+            for (int32_t x = 0; x < w; ++x, dst += 4) {
+                uint16_t c = px[x];
+                uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+                dst[0] = static_cast<uint8_t>((b << 3) | (b >> 2));
+                dst[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+                dst[2] = static_cast<uint8_t>((r << 3) | (r >> 2));
+                dst[3] = 0xFF;
+            }
+            break;
+        }
+        case LV_COLOR_FORMAT_RGB888:
+            for (int32_t x = 0; x < w; ++x, dst += 4) {
+                dst[0] = src[x * 3];
+                dst[1] = src[x * 3 + 1];
+                dst[2] = src[x * 3 + 2];
+                dst[3] = 0xFF;
+            }
+            break;
+        default:
+            std::memcpy(dst, src, w * 4);
+            break;
+        }
+    }
+}
+
+bool isNativeLayout(lv_color_format_t format) {
+    return format == LV_COLOR_FORMAT_NATIVE || format == LV_COLOR_FORMAT_XRGB8888 ||
+           format == LV_COLOR_FORMAT_ARGB8888;
+}
+
+} // namespace
+
+LVGLApplication::LVGLApplication()
+    : display_(NULL), initialized_(false), backend_(Backend::Sdl), quit_(false), frameRequested_(false), wakeEventType_(0),
+      sdlEventTimer_(NULL), inputActive_(true), indevReadPending_(false), lastInputTick_(0), wakePending_(false),
+      pointer_(NULL), keypad_(NULL), pointerPos_{0, 0}, pointerPressed_(false), sdlFlush_(NULL), windowFrameData_(NULL), copyToWindow_(false), rendering_(false),
+      framePending_(false),
+      latencyPending_(false), latencyArmed_(false), latencyStartTick_(0), statsIntervalMs_(0) {
+    std::cout << "LVGL Application initializing..." << std::endl;
+}
+
+LVGLApplication::~LVGLApplication() {
+    cleanup();
+}
+
+bool LVGLApplication::initialize(int32_t width, int32_t height, uint32_t drawUnits) {
+    DisplayConfig config;
+    config.width = width;
+    config.height = height;
+    return initialize(config, drawUnits);
+}
+
+bool LVGLApplication::initialize(const DisplayConfig& config, uint32_t drawUnits) {
+    if (!initLvgl(drawUnits)) {
+        return false;
+    }
+
+    try {
+        // Initialize the display and input devices
+        std::vector<lv_timer_t*> timersBefore = listTimers();
+        display_ = initSdl(config.width, config.height);
+        if (!display_) {
+            std::cerr << "Failed to initialize display!" << std::endl;
+            return false;
+        }
+        backend_ = Backend::Sdl;
+
+        // Every flush goes through sdlFlushCb, which hands complete frames to the driver
+        sdlFlush_ = display_->flush_cb;
+        lv_display_set_flush_cb(display_, sdlFlushCb);
+        lv_display_set_user_data(display_, this);
+        lv_display_add_event_cb(display_, resolutionChangedCb, LV_EVENT_RESOLUTION_CHANGED, this);
+        if (!applyDisplayConfig(config)) {
+            return false;
+        }
+        findInputTimers(timersBefore);
+        wakeEventType_ = SDL_RegisterEvents(1);
+        initFrameStats();
+
+        initialized_ = true;
+        std::cout << "LVGL Application initialized successfully" << std::endl;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception during initialization: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool LVGLApplication::initializeHeadless(const HeadlessConfig& config, uint32_t drawUnits) {
+    if (!initLvgl(drawUnits)) {
+        return false;
+    }
+
+    try {
+        display_ = initHeadless(config);
+        if (!display_) {
+            std::cerr << "Failed to initialize headless display!" << std::endl;
+            return false;
+        }
+        backend_ = Backend::Headless;
+        initFrameStats();
+
+        initialized_ = true;
+        std::cout << "LVGL Application initialized headless (" << config.width << "x" << config.height << ")"
+                  << std::endl;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception during initialization: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool LVGLApplication::runDemo(int argc, char** argv) {
+    if (!initialized_) {
+        std::cerr << "LVGL not initialized!" << std::endl;
+        return false;
+    }
+
+    try {
+        // Open a demo or an example
+        if (argc == 0) {
+            lv_demo_widgets();
+            // lv_example_chart_1();
+        } else {
+            if (!lv_demos_create(&argv[1], argc - 1)) {
+                lv_demos_show_help();
+                return false;
+            }
+        }
+
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception during demo execution: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void LVGLApplication::run() {
+    if (!initialized_) {
+        std::cerr << "LVGL not initialized!" << std::endl;
+        return;
+    }
+
+    std::cout << "Starting main loop..." << std::endl;
+
+    try {
+        Clock::time_point reportStart = Clock::now();
+        std::clock_t reportCpuStart = std::clock();
+        LoopStats reportBase = stats_;
+        FrameStats frameBase = frames_;
+
+        while (!quit_) {
+            Clock::time_point busyStart = Clock::now();
+            latencyArmed_ = latencyPending_ && !indevReadPending_;
+            uint32_t timeUntilNext = lv_timer_handler();
+            Clock::time_point busyEnd = Clock::now();
+            stats_.busyUs += elapsedUs(busyStart, busyEnd);
+            if (framePending_) {
+                commitFrame(elapsedUs(busyStart, busyEnd));
+            }
+            ++stats_.wakeups;
+            if (latencyArmed_) {
+                // The input was read but changed nothing on screen, there is no frame to wait for
+                latencyPending_ = false;
+                latencyArmed_ = false;
+            }
+
+            if (indevReadPending_) {
+                // The SDL timer just stored the new input state, read it right away
+                // instead of waiting for the read timers' period
+                indevReadPending_ = false;
+                for (lv_timer_t* timer : indevTimers_) {
+                    lv_timer_ready(timer);
+                }
+                lv_timer_ready(lv_display_get_refr_timer(display_));
+                continue;
+            }
+            if (sdlEventTimer_ && inputActive_ && inputIdle()) {
+                setInputActive(false);
+            } else if (sdlEventTimer_ && !inputActive_) {
+                // A non-input event or a wakeup ran the SDL timer for this pass only
+                lv_timer_pause(sdlEventTimer_);
+            }
+
+            waitForWork(timeUntilNext);
+            stats_.idleUs += elapsedUs(busyEnd, Clock::now());
+            if (frameRequested_.exchange(false)) {
+                lv_timer_ready(lv_display_get_refr_timer(display_));
+            }
+
+            if (statsIntervalMs_ && elapsedUs(reportStart, Clock::now()) >= statsIntervalMs_ * 1000ull) {
+                printLoopStats(reportBase, reportStart, reportCpuStart);
+                printFrames(frameDelta(frames_, frameBase), elapsedUs(reportStart, Clock::now()) / 1e6);
+                reportStart = Clock::now();
+                reportCpuStart = std::clock();
+                reportBase = stats_;
+                frameBase = frames_;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in main loop: " << e.what() << std::endl;
+    }
+}
+
+void LVGLApplication::renderFrame() {
+    if (display_) {
+        lv_refr_now(display_);
+        if (framePending_) {
+            commitFrame(0);
+        }
+    }
+}
+
+void LVGLApplication::wakeup() {
+    if (backend_ == Backend::Headless) {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            wakePending_ = true;
+        }
+        wakeCond_.notify_one();
+        return;
+    }
+    SDL_Event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = wakeEventType_;
+    SDL_PushEvent(&event);
+}
+
+void LVGLApplication::requestFrame() {
+    frameRequested_ = true;
+    wakeup();
+}
+
+void LVGLApplication::quit() {
+    quit_ = true;
+    wakeup();
+}
+
+void LVGLApplication::injectPointer(int32_t x, int32_t y, bool pressed) {
+    if (!pointer_) {
+        return;
+    }
+    pointerPos_.x = x;
+    pointerPos_.y = y;
+    pointerPressed_ = pressed;
+    lastInputTick_ = lv_tick_get();
+    lv_indev_read(pointer_);
+}
+
+void LVGLApplication::injectClick(int32_t x, int32_t y) {
+    injectPointer(x, y, true);
+    injectPointer(x, y, false);
+}
+
+void LVGLApplication::injectKey(uint32_t key, bool pressed) {
+    if (!keypad_) {
+        return;
+    }
+    keys_.emplace_back(key, pressed);
+    lastInputTick_ = lv_tick_get();
+    lv_indev_read(keypad_);
+}
+
+void LVGLApplication::setStatsInterval(uint32_t intervalMs) {
+    statsIntervalMs_ = intervalMs;
+}
+
+const LoopStats& LVGLApplication::loopStats() const {
+    return stats_;
+}
+
+const FrameStats& LVGLApplication::frameStats() const {
+    return frames_;
+}
+
+void LVGLApplication::resetFrameStats() {
+    uint64_t bufferBytes = frames_.bufferBytes;
+    frames_ = FrameStats();
+    frames_.bufferBytes = bufferBytes;
+}
+
+void LVGLApplication::printFrameStats(double seconds) const {
+    printFrames(frames_, seconds);
+}
+
+const DisplayConfig& LVGLApplication::displayConfig() const {
+    return displayConfig_;
+}
+
+const FrameRecorder& LVGLApplication::frameRecorder() const {
+    return recorder_;
+}
+
+void LVGLApplication::setFrameReport(const std::string& path) {
+    frameReportPath_ = path;
+}
+
+void LVGLApplication::cleanup() {
+    if (initialized_) {
+        if (!frameReportPath_.empty() && !recorder_.writeJson(frameReportPath_)) {
+            std::cerr << "Failed to write frame report " << frameReportPath_ << std::endl;
+        }
+        std::cout << "Cleaning up LVGL..." << std::endl;
+        lv_deinit();
+        initialized_ = false;
+        display_ = NULL;
+        pointer_ = NULL;
+        keypad_ = NULL;
+        sdlEventTimer_ = NULL;
+        indevTimers_.clear();
+        keys_.clear();
+        ownedBuffer_.clear();
+        ownedBuffer_.shrink_to_fit();
+        for (std::vector<uint8_t>& buffer : renderBuffers_) {
+            buffer.clear();
+            buffer.shrink_to_fit();
+        }
+        windowFrame_.clear();
+        windowFrame_.shrink_to_fit();
+        windowFrameData_ = NULL;
+        sdlFlush_ = NULL;
+    }
+}
+
+lv_display_t* LVGLApplication::getDisplay() const {
+    return display_;
+}
+
+LVGLApplication::Backend LVGLApplication::backend() const {
+    return backend_;
+}
+
+bool LVGLApplication::isInitialized() const {
+    return initialized_;
+}
+
+bool LVGLApplication::initLvgl(uint32_t drawUnits) {
+    if (initialized_) {
+        std::cerr << "LVGL already initialized!" << std::endl;
+        return false;
+    }
+
+    // Initialize LVGL
+    lv_init();
+
+    // LV_DRAW_SW_DRAW_UNIT_CNT is the build-time maximum, use fewer if asked to
+    uint32_t activeUnits = DrawUnits::setActive(drawUnits);
+    std::cout << "Rendering with " << activeUnits << " of " << DrawUnits::available() << " draw units"
+              << std::endl;
+    return true;
+}
+
+void LVGLApplication::initFrameStats() {
+    lv_display_add_event_cb(display_, refrStartCb, LV_EVENT_REFR_START, this);
+    lv_display_add_event_cb(display_, renderStartCb, LV_EVENT_RENDER_START, this);
+    lv_display_add_event_cb(display_, refrReadyCb, LV_EVENT_REFR_READY, this);
+    lv_display_add_event_cb(display_, renderReadyCb, LV_EVENT_RENDER_READY, this);
+    lv_display_add_event_cb(display_, flushStartCb, LV_EVENT_FLUSH_START, this);
+    lv_display_add_event_cb(display_, flushFinishCb, LV_EVENT_FLUSH_FINISH, this);
+    lv_display_add_event_cb(display_, flushStartCb, LV_EVENT_FLUSH_WAIT_START, this);
+    lv_display_add_event_cb(display_, flushFinishCb, LV_EVENT_FLUSH_WAIT_FINISH, this);
+}
+
+/**
+ * Initialize the Hardware Abstraction Layer (HAL) for the LVGL graphics
+ * library
+ */
+lv_display_t* LVGLApplication::initSdl(int32_t width, int32_t height) {
+    lv_group_set_default(lv_group_create());
+
+    lv_display_t* disp = lv_sdl_window_create(width, height);
+
+    lv_indev_t* mouse = lv_sdl_mouse_create();
+    lv_indev_set_group(mouse, lv_group_get_default());
+    lv_indev_set_display(mouse, disp);
+    lv_display_set_default(disp);
+
+    LV_IMAGE_DECLARE(mouse_cursor_icon); /*Declare the image file.*/
+    lv_obj_t* cursor_obj;
+    cursor_obj = lv_image_create(lv_screen_active()); /*Create an image object for the cursor */
+    lv_image_set_src(cursor_obj, &mouse_cursor_icon);   /*Set the image source*/
+    lv_indev_set_cursor(mouse, cursor_obj);             /*Connect the image  object to the driver*/
+
+    lv_indev_t* mousewheel = lv_sdl_mousewheel_create();
+    lv_indev_set_display(mousewheel, disp);
+
+    lv_indev_t* keyboard = lv_sdl_keyboard_create();
+    lv_indev_set_display(keyboard, disp);
+    lv_indev_set_group(keyboard, lv_group_get_default());
+
+    return disp;
+}
+
+bool LVGLApplication::applyDisplayConfig(const DisplayConfig& config) {
+    if (backend_ != Backend::Sdl || !display_ || !sdlFlush_) {
+        std::cerr << "Display config needs the SDL backend" << std::endl;
+        return false;
+    }
+    if (config.bufferCount < 1 || config.bufferCount > 2) {
+        std::cerr << "Buffer count must be 1 or 2" << std::endl;
+        return false;
+    }
+    if (!isNativeLayout(config.colorFormat) && config.colorFormat != LV_COLOR_FORMAT_RGB888 &&
+        config.colorFormat != LV_COLOR_FORMAT_RGB565) {
+        std::cerr << "Unsupported color format " << config.colorFormat << std::endl;
+        return false;
+    }
+    displayConfig_ = config;
+    return allocateSdlBuffers();
+}
+
+bool LVGLApplication::allocateSdlBuffers() {
+    const DisplayConfig& config = displayConfig_;
+    int32_t hor = lv_display_get_horizontal_resolution(display_);
+    int32_t ver = lv_display_get_vertical_resolution(display_);
+    lv_color_format_t format = config.colorFormat == LV_COLOR_FORMAT_NATIVE ? LV_COLOR_FORMAT_NATIVE
+                                                                            : config.colorFormat;
+
+    uint32_t stride = lv_draw_buf_width_to_stride(hor, format);
+    uint32_t lines = ver;
+    if (config.renderMode == LV_DISPLAY_RENDER_MODE_PARTIAL && config.bufferLines) {
+        lines = std::min<uint32_t>(config.bufferLines, ver);
+    }
+    uint32_t size = stride * lines;
+
+    uint8_t* buffers[2] = {NULL, NULL};
+    for (uint32_t i = 0; i < 2; ++i) {
+        if (i < config.bufferCount) {
+            renderBuffers_[i].assign(size + LV_DRAW_BUF_ALIGN, 0);
+            buffers[i] = static_cast<uint8_t*>(lv_draw_buf_align(renderBuffers_[i].data(), format));
+        } else {
+            renderBuffers_[i].clear();
+            renderBuffers_[i].shrink_to_fit();
+        }
+    }
+
+    copyToWindow_ = config.renderMode == LV_DISPLAY_RENDER_MODE_PARTIAL || !isNativeLayout(format);
+    uint32_t frameSize = lv_draw_buf_width_to_stride(hor, LV_COLOR_FORMAT_XRGB8888) * ver;
+    if (copyToWindow_) {
+        windowFrame_.assign(frameSize + LV_DRAW_BUF_ALIGN, 0);
+        windowFrameData_ =
+            static_cast<uint8_t*>(lv_draw_buf_align(windowFrame_.data(), LV_COLOR_FORMAT_XRGB8888));
+    } else {
+        windowFrame_.clear();
+        windowFrame_.shrink_to_fit();
+        windowFrameData_ = NULL;
+    }
+
+    // The buffers are sized for the format, so it is set first
+    lv_display_set_color_format(display_, format);
+    lv_display_set_buffers(display_, buffers[0], buffers[1], size, config.renderMode);
+    frames_.bufferBytes = static_cast<uint64_t>(size) * config.bufferCount + (copyToWindow_ ? frameSize : 0);
+    lv_obj_invalidate(lv_display_get_screen_active(display_));
+    return true;
+}
+
+/**
+ * Create a display that renders into memory and input devices that are
+ * only read when something is injected, so nothing polls while idle
+ */
+lv_display_t* LVGLApplication::initHeadless(const HeadlessConfig& config) {
+    // Without SDL nobody provides the tick
+    lv_tick_set_cb(steadyTickCb);
+
+    headless_ = config;
+    uint32_t stride = lv_draw_buf_width_to_stride(config.width, config.colorFormat);
+    uint32_t frameSize = stride * config.height;
+    if (!headless_.buffer) {
+        if (config.renderMode == LV_DISPLAY_RENDER_MODE_PARTIAL && config.bufferSize) {
+            frameSize = config.bufferSize;
+        }
+        ownedBuffer_.assign(frameSize + LV_DRAW_BUF_ALIGN, 0);
+        headless_.buffer = static_cast<uint8_t*>(lv_draw_buf_align(ownedBuffer_.data(), config.colorFormat));
+        headless_.bufferSize = frameSize;
+    } else if (config.renderMode != LV_DISPLAY_RENDER_MODE_PARTIAL && config.bufferSize < frameSize) {
+        std::cerr << "Headless buffer too small: " << config.bufferSize << " < " << frameSize << " bytes"
+                  << std::endl;
+        return NULL;
+    }
+
+    lv_display_t* disp = lv_display_create(config.width, config.height);
+    if (!disp) {
+        return NULL;
+    }
+    lv_display_set_color_format(disp, config.colorFormat);
+    lv_display_set_buffers(disp, headless_.buffer, NULL, headless_.bufferSize, config.renderMode);
+    frames_.bufferBytes = headless_.bufferSize;
+    lv_display_set_flush_cb(disp, headlessFlushCb);
+    lv_display_set_user_data(disp, this);
+    lv_display_set_default(disp);
+
+    lv_group_set_default(lv_group_create());
+
+    // Event mode: read on lv_indev_read() only, there is no read timer to wake the loop
+    pointer_ = lv_indev_create();
+    lv_indev_set_type(pointer_, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(pointer_, pointerReadCb);
+    lv_indev_set_user_data(pointer_, this);
+    lv_indev_set_display(pointer_, disp);
+    lv_indev_set_mode(pointer_, LV_INDEV_MODE_EVENT);
+
+    keypad_ = lv_indev_create();
+    lv_indev_set_type(keypad_, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_read_cb(keypad_, keypadReadCb);
+    lv_indev_set_user_data(keypad_, this);
+    lv_indev_set_display(keypad_, disp);
+    lv_indev_set_group(keypad_, lv_group_get_default());
+    lv_indev_set_mode(keypad_, LV_INDEV_MODE_EVENT);
+
+    return disp;
+}
+
+uint64_t LVGLApplication::elapsedUs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
+
+std::vector<lv_timer_t*> LVGLApplication::listTimers() {
+    std::vector<lv_timer_t*> timers;
+    for (lv_timer_t* timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer)) {
+        timers.push_back(timer);
+    }
+    return timers;
+}
+
+/**
+ * Find the timers initSdl created for input
+ *
+ * The SDL driver polls its events from a timer without user data, the
+ * display refresh timer carries the display and each input device's
+ * read timer is reachable through the device.
+ */
+void LVGLApplication::findInputTimers(const std::vector<lv_timer_t*>& timersBefore) {
+    lv_timer_t* refrTimer = lv_display_get_refr_timer(display_);
+    for (lv_timer_t* timer : listTimers()) {
+        bool isNew = std::find(timersBefore.begin(), timersBefore.end(), timer) == timersBefore.end();
+        if (isNew && timer != refrTimer && lv_timer_get_user_data(timer) == NULL) {
+            sdlEventTimer_ = timer;
+        }
+    }
+    for (lv_indev_t* indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        if (lv_timer_t* timer = lv_indev_get_read_timer(indev)) {
+            indevTimers_.push_back(timer);
+        }
+    }
+}
+
+/**
+ * No input for a while and nothing pressed or scrolling
+ */
+bool LVGLApplication::inputIdle() const {
+    if (lv_tick_elaps(lastInputTick_) < INPUT_IDLE_MS) {
+        return false;
+    }
+    for (lv_indev_t* indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        if (lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED || lv_indev_get_scroll_obj(indev)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LVGLApplication::setInputActive(bool active) {
+    inputActive_ = active;
+    for (lv_timer_t* timer : indevTimers_) {
+        if (active) {
+            lv_timer_resume(timer);
+        } else {
+            lv_timer_pause(timer);
+        }
+    }
+    if (sdlEventTimer_ && !active) {
+        lv_timer_pause(sdlEventTimer_);
+    }
+}
+
+bool LVGLApplication::isInputEvent(uint32_t type) {
+    return type >= SDL_KEYDOWN && type <= SDL_MOUSEWHEEL;
+}
+
+/**
+ * Block until the next LVGL timer or the next event
+ */
+void LVGLApplication::waitForWork(uint32_t timeUntilNext) {
+    if (backend_ == Backend::Headless) {
+        waitForWakeup(timeUntilNext);
+    } else {
+        waitForSdl(timeUntilNext);
+    }
+}
+
+void LVGLApplication::waitForSdl(uint32_t timeUntilNext) {
+    int ready;
+    if (timeUntilNext == LV_NO_TIMER_READY) {
+        ready = SDL_WaitEvent(NULL);
+    } else if (timeUntilNext == 0) {
+        ready = SDL_PollEvent(NULL);
+    } else {
+        ready = SDL_WaitEventTimeout(NULL, static_cast<int>(timeUntilNext));
+    }
+    if (!ready || !sdlEventTimer_) {
+        return;
+    }
+
+    // The events stay queued for the SDL driver, only peek at them here
+    SDL_Event events[16];
+    int count = SDL_PeepEvents(events, 16, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    bool input = false;
+    for (int i = 0; i < count; ++i) {
+        if (isInputEvent(events[i].type)) {
+            if (!input && !latencyPending_) {
+                latencyPending_ = true;
+                latencyStartTick_ = events[i].common.timestamp;
+            }
+            input = true;
+        }
+    }
+
+    // Every event needs one SDL timer pass to leave the queue; without input
+    // run() pauses the timer again right after that pass
+    ++stats_.eventWakeups;
+    lv_timer_resume(sdlEventTimer_);
+    lv_timer_ready(sdlEventTimer_);
+    if (input) {
+        lastInputTick_ = lv_tick_get();
+        indevReadPending_ = true;
+        if (!inputActive_) {
+            setInputActive(true);
+        }
+    }
+}
+
+/**
+ * Headless: there is no event queue, only wakeup() ends the wait early
+ */
+void LVGLApplication::waitForWakeup(uint32_t timeUntilNext) {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    auto woken = [this] { return wakePending_ || quit_; };
+    bool early;
+    if (timeUntilNext == LV_NO_TIMER_READY) {
+        wakeCond_.wait(lock, woken);
+        early = true;
+    } else {
+        early = wakeCond_.wait_for(lock, std::chrono::milliseconds(timeUntilNext), woken);
+    }
+    if (early) {
+        ++stats_.eventWakeups;
+    }
+    wakePending_ = false;
+}
+
+void LVGLApplication::refrStartCb(lv_event_t* e) {
+    auto* self = static_cast<LVGLApplication*>(lv_event_get_user_data(e));
+    if (self->framePending_) {
+        // Refreshed by someone else's lv_timer_handler or lv_refr_now
+        self->commitFrame(0);
+    }
+    self->refrStart_ = Clock::now();
+    self->rendering_ = false;
+    self->frame_ = FrameSample();
+}
+
+/**
+ * Everything before the first area is rendered, modifier flushes and
+ * layout included, counts as layout time
+ */
+void LVGLApplication::renderStartCb(lv_event_t* e) {
+    auto* self = static_cast<LVGLApplication*>(lv_event_get_user_data(e));
+    if (self->rendering_) {
+        return;
+    }
+    self->rendering_ = true;
+    self->renderStart_ = Clock::now();
+    uint64_t layoutUs = elapsedUs(self->refrStart_, self->renderStart_);
+    self->frames_.layoutUs += layoutUs;
+    ++self->frames_.frames;
+
+    // The invalidated areas are joined by now, overlapping ones are marked
+    lv_display_t* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    self->frame_.layoutUs = static_cast<uint32_t>(layoutUs);
+    for (uint32_t i = 0; i < disp->inv_p; ++i) {
+        if (!disp->inv_area_joined[i]) {
+            ++self->frame_.areas;
+            self->frame_.pixels += lv_area_get_size(&disp->inv_areas[i]);
+        }
+    }
+}
+
+void LVGLApplication::renderReadyCb(lv_event_t* e) {
+    auto* self = static_cast<LVGLApplication*>(lv_event_get_user_data(e));
+    uint64_t renderUs = elapsedUs(self->renderStart_, Clock::now());
+    self->frame_.drawUs = static_cast<uint32_t>(renderUs > self->frame_.flushUs ? renderUs - self->frame_.flushUs : 0);
+}
+
+void LVGLApplication::flushStartCb(lv_event_t* e) {
+    auto* self = static_cast<LVGLApplication*>(lv_event_get_user_data(e));
+    self->flushStart_ = Clock::now();
+}
+
+void LVGLApplication::flushFinishCb(lv_event_t* e) {
+    auto* self = static_cast<LVGLApplication*>(lv_event_get_user_data(e));
+    self->frame_.flushUs += static_cast<uint32_t>(elapsedUs(self->flushStart_, Clock::now()));
+}
+
+/**
+ * The frame is recorded once the lv_timer_handler pass that rendered it
+ * returns, the rest of that pass is attributed to the other timers
+ */
+void LVGLApplication::commitFrame(uint64_t handlerUs) {
+    frame_.timerUs = static_cast<uint32_t>(handlerUs > frame_.totalUs ? handlerUs - frame_.totalUs : 0);
+    recorder_.record(frame_);
+    framePending_ = false;
+}
+
+/**
+ * Frame time, and input latency: first frame rendered after an input was read
+ */
+void LVGLApplication::refrReadyCb(lv_event_t* e) {
+    auto* self = static_cast<LVGLApplication*>(lv_event_get_user_data(e));
+    uint64_t us = elapsedUs(self->refrStart_, Clock::now());
+    ++self->frames_.refreshes;
+    self->frames_.refreshUs += us;
+    if (self->rendering_) {
+        self->frames_.lastFrameUs = us;
+        self->frame_.totalUs = static_cast<uint32_t>(us);
+        self->framePending_ = true;
+    } else {
+        self->frames_.layoutUs += us;
+    }
+
+    if (!self->latencyArmed_) {
+        return;
+    }
+    uint32_t latency = lv_tick_elaps(self->latencyStartTick_);
+    ++self->stats_.latencySamples;
+    self->stats_.latencySumMs += latency;
+    if (latency > self->stats_.latencyMaxMs) {
+        self->stats_.latencyMaxMs = latency;
+    }
+    self->latencyPending_ = false;
+    self->latencyArmed_ = false;
+}
+
+void LVGLApplication::headlessFlushCb(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap) {
+    auto* self = static_cast<LVGLApplication*>(lv_display_get_user_data(disp));
+    Clock::time_point start = Clock::now();
+    ++self->frames_.flushes;
+    self->frames_.flushedPixels += lv_area_get_size(area);
+    if (self->headless_.onFlush) {
+        self->headless_.onFlush(*area, pxMap);
+    }
+    lv_display_flush_ready(disp);
+    self->frames_.flushUs += elapsedUs(start, Clock::now());
+}
+
+/**
+ * The driver expects a full native frame on the last flush of a refresh.
+ * DIRECT and FULL buffers in the native format are that frame already;
+ * otherwise each flushed area is copied into windowFrame_ and that is
+ * handed over instead.
+ */
+void LVGLApplication::sdlFlushCb(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap) {
+    auto* self = static_cast<LVGLApplication*>(lv_display_get_user_data(disp));
+    Clock::time_point start = Clock::now();
+    ++self->frames_.flushes;
+    self->frames_.flushedPixels += lv_area_get_size(area);
+
+    uint8_t* frame = pxMap;
+    if (self->copyToWindow_) {
+        lv_color_format_t format = lv_display_get_color_format(disp);
+        int32_t hor = lv_display_get_horizontal_resolution(disp);
+        uint32_t frameStride = lv_draw_buf_width_to_stride(hor, LV_COLOR_FORMAT_XRGB8888);
+        const uint8_t* src = pxMap;
+        uint32_t srcStride;
+        if (self->displayConfig_.renderMode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            srcStride = lv_draw_buf_width_to_stride(lv_area_get_width(area), format);
+        } else {
+            srcStride = lv_draw_buf_width_to_stride(hor, format);
+            src += area->y1 * srcStride + area->x1 * lv_color_format_get_size(format);
+        }
+        Clock::time_point copyStart = Clock::now();
+        copyToNative(*area, src, srcStride, format, self->windowFrameData_, frameStride);
+        self->frames_.copyUs += elapsedUs(copyStart, Clock::now());
+        self->frames_.copiedPixels += lv_area_get_size(area);
+        frame = self->windowFrameData_;
+    }
+
+    if (lv_display_flush_is_last(disp)) {
+        // Uploads the frame to the window's texture, presents it and reports the flush ready
+        self->sdlFlush_(disp, area, frame);
+    } else {
+        lv_display_flush_ready(disp);
+    }
+    self->frames_.flushUs += elapsedUs(start, Clock::now());
+}
+
+/**
+ * The driver resets the buffers to its own when the window is resized
+ */
+void LVGLApplication::resolutionChangedCb(lv_event_t* e) {
+    auto* self = static_cast<LVGLApplication*>(lv_event_get_user_data(e));
+    if (self->sdlFlush_) {
+        self->allocateSdlBuffers();
+    }
+}
+
+void LVGLApplication::pointerReadCb(lv_indev_t* indev, lv_indev_data_t* data) {
+    auto* self = static_cast<LVGLApplication*>(lv_indev_get_user_data(indev));
+    data->point = self->pointerPos_;
+    data->state = self->pointerPressed_ ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void LVGLApplication::keypadReadCb(lv_indev_t* indev, lv_indev_data_t* data) {
+    auto* self = static_cast<LVGLApplication*>(lv_indev_get_user_data(indev));
+    if (self->keys_.empty()) {
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+    data->key = self->keys_.front().first;
+    data->state = self->keys_.front().second ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    self->keys_.pop_front();
+    data->continue_reading = !self->keys_.empty();
+}
+
+uint32_t LVGLApplication::steadyTickCb() {
+    static const Clock::time_point start = Clock::now();
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+}
+
+FrameStats LVGLApplication::frameDelta(const FrameStats& now, const FrameStats& base) {
+    FrameStats delta = now;
+    delta.refreshes -= base.refreshes;
+    delta.frames -= base.frames;
+    delta.flushes -= base.flushes;
+    delta.flushedPixels -= base.flushedPixels;
+    delta.flushUs -= base.flushUs;
+    delta.copiedPixels -= base.copiedPixels;
+    delta.copyUs -= base.copyUs;
+    delta.refreshUs -= base.refreshUs;
+    delta.layoutUs -= base.layoutUs;
+    return delta;
+}
+
+void LVGLApplication::printFrames(const FrameStats& f, double seconds) {
+    std::cout << "frames: " << f.frames << " of " << f.refreshes << " refreshes";
+    if (seconds > 0) {
+        std::cout << ", " << f.frames / seconds << " fps";
+    }
+    if (f.refreshes) {
+        std::cout << ", refresh avg " << static_cast<double>(f.refreshUs) / f.refreshes / 1000 << " ms, layout "
+                  << static_cast<double>(f.layoutUs) / f.refreshes / 1000 << " ms";
+    }
+    if (f.flushes) {
+        std::cout << ", " << f.flushes << " flushes, " << f.flushedPixels << " px";
+    }
+    if (f.frames) {
+        std::cout << ", flush " << static_cast<double>(f.flushUs) / f.frames / 1000 << " ms/frame";
+        if (f.copiedPixels) {
+            std::cout << " (copy " << static_cast<double>(f.copyUs) / f.frames / 1000 << " ms, "
+                      << f.copiedPixels / f.frames << " px)";
+        }
+    }
+    std::cout << ", buffers " << f.bufferBytes / 1024 << " KiB" << std::endl;
+}
+
+void LVGLApplication::printLoopStats(const LoopStats& base, Clock::time_point start, std::clock_t cpuStart) const {
+    double wallS = elapsedUs(start, Clock::now()) / 1e6;
+    double cpuS = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    uint64_t wakeups = stats_.wakeups - base.wakeups;
+    uint64_t busyUs = stats_.busyUs - base.busyUs;
+    uint64_t samples = stats_.latencySamples - base.latencySamples;
+    uint64_t latencySum = stats_.latencySumMs - base.latencySumMs;
+
+    std::cout << "loop: " << wakeups / wallS << " wakeups/s, busy " << busyUs / 1e4 / wallS << "%, cpu "
+              << cpuS * 100 / wallS << "%";
+    if (samples) {
+        std::cout << ", input latency avg " << static_cast<double>(latencySum) / samples << " ms, max "
+                  << stats_.latencyMaxMs << " ms (" << samples << " samples)";
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,356 @@
+/**
+ * @file LVGLApplication.h
+ * @brief C++ wrapper around LVGL initialization and the main loop
+ */
+
+#pragma once
+
+#include "lvgl/lvgl.h"
+#include "FrameRecorder.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Main loop counters, for idle CPU use and input latency
+ */
+struct LoopStats {
+    uint64_t wakeups = 0;         /**< lv_timer_handler calls */
+    uint64_t eventWakeups = 0;    /**< Waits ended early by an SDL event or wakeup() */
+    uint64_t busyUs = 0;          /**< Time spent in lv_timer_handler */
+    uint64_t idleUs = 0;          /**< Time spent waiting */
+    uint64_t latencySamples = 0;  /**< Input events that reached a rendered frame */
+    uint64_t latencySumMs = 0;
+    uint32_t latencyMaxMs = 0;
+};
+
+/**
+ * @brief Display refresh counters, for frames per second and layout cost
+ */
+struct FrameStats {
+    uint64_t refreshes = 0;       /**< Refresh timer passes */
+    uint64_t frames = 0;          /**< Refreshes that rendered something */
+    uint64_t flushes = 0;         /**< Flush callbacks */
+    uint64_t flushedPixels = 0;   /**< Pixels handed to the flush callback */
+    uint64_t flushUs = 0;         /**< Time in the flush callback, texture upload and present included */
+    uint64_t copiedPixels = 0;    /**< Pixels copied or converted into the window's frame (SDL backend) */
+    uint64_t copyUs = 0;          /**< Part of flushUs spent on that copy */
+    uint64_t refreshUs = 0;       /**< Time from refresh start to refresh ready */
+    uint64_t layoutUs = 0;        /**< Part of it spent before rendering: modifier flush and layout */
+    uint64_t lastFrameUs = 0;
+    uint64_t bufferBytes = 0;     /**< Render buffers plus the window's frame, if a separate one is needed */
+};
+
+/**
+ * @brief Buffering of the SDL display
+ *
+ * The SDL driver's render mode is fixed at build time (LV_SDL_RENDER_MODE).
+ * This configuration is applied on top of it at runtime, so a deployment
+ * can trade buffer memory for throughput without rebuilding:
+ *  - PARTIAL renders into small buffers, flushed areas are copied into the window's frame
+ *  - DIRECT renders straight into a full-size frame, only dirty areas are redrawn
+ *  - FULL redraws the whole frame every refresh
+ * Color formats other than the native one halve or shrink the buffers, at
+ * the cost of a conversion when flushing.
+ */
+struct DisplayConfig {
+    int32_t width = 480;
+    int32_t height = 320;
+    lv_display_render_mode_t renderMode = LV_DISPLAY_RENDER_MODE_DIRECT;
+    uint32_t bufferCount = 1;     /**< 1, or 2 to render into one buffer while the other is shown */
+    uint32_t bufferLines = 0;     /**< PARTIAL only: lines per buffer, 0 for a full frame */
+
+    /** LV_COLOR_FORMAT_NATIVE, XRGB8888, ARGB8888, RGB888 or RGB565 */
+    lv_color_format_t colorFormat = LV_COLOR_FORMAT_NATIVE;
+};
+
+/**
+ * @brief Settings of the headless in-memory display
+ */
+struct HeadlessConfig {
+    int32_t width = 480;
+    int32_t height = 320;
+
+    /**
+     * Caller-owned frame buffer, width * height pixels for the direct and
+     * full render modes. Left empty, the application allocates one.
+     */
+    uint8_t* buffer = NULL;
+    uint32_t bufferSize = 0;
+
+    lv_color_format_t colorFormat = LV_COLOR_FORMAT_NATIVE;
+    lv_display_render_mode_t renderMode = LV_DISPLAY_RENDER_MODE_DIRECT;
+
+    /** Called for every flushed area, before LVGL is told the flush is done */
+    std::function<void(const lv_area_t& area, const uint8_t* pixels)> onFlush;
+};
+
+/**
+ * @brief LVGL Application class
+ *
+ * This class provides a C++ wrapper around the LVGL functionality. It drives
+ * either an SDL window with mouse, wheel and keyboard, or a headless display
+ * rendering into memory with virtual input devices.
+ */
+class LVGLApplication {
+public:
+    enum class Backend {
+        Sdl,
+        Headless,
+    };
+
+    /**
+     * @brief Constructor
+     */
+    LVGLApplication();
+
+    /**
+     * @brief Destructor
+     */
+    ~LVGLApplication();
+
+    /**
+     * @brief Initialize the LVGL application with an SDL window
+     * @param width Display width
+     * @param height Display height
+     * @param drawUnits Software draw units (render threads) to use, 0 for all compiled in
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize(int32_t width, int32_t height, uint32_t drawUnits = 0);
+
+    /**
+     * @brief Initialize the LVGL application with an SDL window and chosen buffering
+     * @param config Window size, render mode, buffers and color format
+     * @param drawUnits Software draw units (render threads) to use, 0 for all compiled in
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize(const DisplayConfig& config, uint32_t drawUnits = 0);
+
+    /**
+     * @brief Change the buffering of the running SDL display, between frames
+     *
+     * The window keeps its size, config.width and config.height are ignored.
+     * @return false for the headless backend or an unsupported configuration
+     */
+    bool applyDisplayConfig(const DisplayConfig& config);
+
+    const DisplayConfig& displayConfig() const;
+
+    /**
+     * @brief Initialize the LVGL application with a headless in-memory display
+     * @param config Display size, frame buffer and flush callback
+     * @param drawUnits Software draw units (render threads) to use, 0 for all compiled in
+     * @return true if initialization successful, false otherwise
+     */
+    bool initializeHeadless(const HeadlessConfig& config, uint32_t drawUnits = 0);
+
+    /**
+     * @brief Run the demo with specified arguments
+     * @param argc Number of arguments
+     * @param argv Argument array
+     * @return true if demo started successfully, false otherwise
+     */
+    bool runDemo(int argc, char** argv);
+
+    /**
+     * @brief Main application loop
+     *
+     * Sleeps until the next LVGL timer is due or an event arrives,
+     * whichever comes first. With the SDL backend the SDL polling and input
+     * read timers are paused while no input is in progress, so an idle
+     * screen does not wake up at all; the first input event resumes them
+     * without waiting for their period.
+     */
+    void run();
+
+    /**
+     * @brief Refresh the display now, regardless of the refresh period
+     */
+    void renderFrame();
+
+    /**
+     * @brief Wake the main loop up, callable from any thread
+     */
+    void wakeup();
+
+    /**
+     * @brief Wake the main loop up and refresh the display right away, callable from any thread
+     *
+     * For threads handing UI changes to the main loop, e.g. as the wake callback
+     * of DuiMutationQueue, so the change is drawn without waiting for the refresh period.
+     */
+    void requestFrame();
+
+    /**
+     * @brief Make run() return, callable from any thread
+     */
+    void quit();
+
+    /**
+     * @brief Move the virtual pointer of the headless backend and read it at once
+     */
+    void injectPointer(int32_t x, int32_t y, bool pressed);
+
+    /**
+     * @brief Press and release the virtual pointer at a point
+     */
+    void injectClick(int32_t x, int32_t y);
+
+    /**
+     * @brief Queue a key on the virtual keypad of the headless backend and read it at once
+     */
+    void injectKey(uint32_t key, bool pressed);
+
+    /**
+     * @brief Print loop statistics every intervalMs while running, 0 disables
+     */
+    void setStatsInterval(uint32_t intervalMs);
+
+    /**
+     * @brief Loop counters since startup
+     */
+    const LoopStats& loopStats() const;
+
+    /**
+     * @brief Frame counters since startup or the last reset
+     */
+    const FrameStats& frameStats() const;
+    void resetFrameStats();
+
+    /**
+     * @brief Print frames per second, frame time and layout share of the frame counters
+     * @param seconds Wall time the counters cover
+     */
+    void printFrameStats(double seconds) const;
+
+    /**
+     * @brief Timing breakdown of the last rendered frames
+     *
+     * Every rendered frame is recorded with the time spent in other timers,
+     * layout, drawing and flushing, plus the invalidated areas and pixels.
+     * Works in release builds, without LV_USE_PERF_MONITOR or LV_USE_PROFILER.
+     */
+    const FrameRecorder& frameRecorder() const;
+
+    /**
+     * @brief Write the frame percentiles as JSON to path on cleanup, empty disables
+     */
+    void setFrameReport(const std::string& path);
+
+    /**
+     * @brief Cleanup resources
+     */
+    void cleanup();
+
+    /**
+     * @brief Get display pointer
+     * @return Display pointer or NULL if not initialized
+     */
+    lv_display_t* getDisplay() const;
+
+    Backend backend() const;
+
+    /**
+     * @brief Check if application is initialized
+     * @return true if initialized, false otherwise
+     */
+    bool isInitialized() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** Input timers stay active this long after the last input event [ms] */
+    static constexpr uint32_t INPUT_IDLE_MS = 200;
+
+    bool initLvgl(uint32_t drawUnits);
+    void initFrameStats();
+    lv_display_t* initSdl(int32_t width, int32_t height);
+    lv_display_t* initHeadless(const HeadlessConfig& config);
+
+    static uint64_t elapsedUs(Clock::time_point from, Clock::time_point to);
+    static std::vector<lv_timer_t*> listTimers();
+    void findInputTimers(const std::vector<lv_timer_t*>& timersBefore);
+    bool inputIdle() const;
+    void setInputActive(bool active);
+    static bool isInputEvent(uint32_t type);
+    void waitForWork(uint32_t timeUntilNext);
+    void waitForSdl(uint32_t timeUntilNext);
+    void waitForWakeup(uint32_t timeUntilNext);
+
+    static void refrStartCb(lv_event_t* e);
+    static void renderStartCb(lv_event_t* e);
+    static void refrReadyCb(lv_event_t* e);
+    static void renderReadyCb(lv_event_t* e);
+    static void flushStartCb(lv_event_t* e);
+    static void flushFinishCb(lv_event_t* e);
+    void commitFrame(uint64_t handlerUs);
+    static void headlessFlushCb(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap);
+    static void pointerReadCb(lv_indev_t* indev, lv_indev_data_t* data);
+    static void keypadReadCb(lv_indev_t* indev, lv_indev_data_t* data);
+    static uint32_t steadyTickCb();
+
+    bool allocateSdlBuffers();
+    static void sdlFlushCb(lv_display_t* disp, const lv_area_t* area, uint8_t* pxMap);
+    static void resolutionChangedCb(lv_event_t* e);
+    static FrameStats frameDelta(const FrameStats& now, const FrameStats& base);
+    static void printFrames(const FrameStats& frames, double seconds);
+
+    void printLoopStats(const LoopStats& base, Clock::time_point start, std::clock_t cpuStart) const;
+
+    lv_display_t* display_;
+    bool initialized_;
+    Backend backend_;
+
+    // Event-driven loop state
+    std::atomic<bool> quit_;
+    std::atomic<bool> frameRequested_;        /**< Set by requestFrame() */
+    uint32_t wakeEventType_;
+    lv_timer_t* sdlEventTimer_;               /**< The SDL driver's event polling timer */
+    std::vector<lv_timer_t*> indevTimers_;    /**< Read timers of the input devices */
+    bool inputActive_;
+    bool indevReadPending_;
+    uint32_t lastInputTick_;
+    std::mutex wakeMutex_;                    /**< Headless wakeups, there is no SDL queue */
+    std::condition_variable wakeCond_;
+    bool wakePending_;
+
+    // Headless backend
+    HeadlessConfig headless_;
+    std::vector<uint8_t> ownedBuffer_;
+    lv_indev_t* pointer_;
+    lv_indev_t* keypad_;
+    lv_point_t pointerPos_;
+    bool pointerPressed_;
+    std::deque<std::pair<uint32_t, bool>> keys_;
+
+    // SDL buffering
+    DisplayConfig displayConfig_;
+    lv_display_flush_cb_t sdlFlush_;          /**< The SDL driver's flush, it uploads and presents the frame */
+    std::vector<uint8_t> renderBuffers_[2];
+    std::vector<uint8_t> windowFrame_;        /**< Native full frame for PARTIAL and converted formats */
+    uint8_t* windowFrameData_;
+    bool copyToWindow_;
+
+    // Measurements
+    LoopStats stats_;
+    FrameStats frames_;
+    Clock::time_point refrStart_;
+    Clock::time_point renderStart_;
+    Clock::time_point flushStart_;
+    bool rendering_;
+    FrameRecorder recorder_;
+    FrameSample frame_;                       /**< Frame being measured */
+    bool framePending_;                       /**< frame_ is complete but not recorded yet */
+    std::string frameReportPath_;
+    bool latencyPending_;
+    bool latencyArmed_;
+    uint32_t latencyStartTick_;
+    uint32_t statsIntervalMs_;
+};
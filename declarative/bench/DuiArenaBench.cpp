@@ -0,0 +1,117 @@
+/**
+ * @file DuiArenaBench.cpp
+ * @brief Build/teardown time and memory of Dui trees, heap vs. DuiArena
+ *
+ * Usage: DuiArenaBench [materializeLimit]
+ * Trees larger than materializeLimit nodes, unlimited by default, are only
+ * built as descriptions.
+ */
+
+#include "DuiBenchHarness.h"
+#include "lvgl.h"
+#include "LVGLApplication.h"
+#include "core/DuiArena.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include "components/DuiText.h"
+#include "components/DuiButton.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using Clock = DuiBenchHarness::Clock;
+
+struct Result {
+    double constructMs = 0;
+    double buildMs = 0;
+    double teardownMs = 0;
+    std::size_t cppBytes = 0;
+    std::size_t arenaBytes = 0;
+    std::size_t lvglBytes = 0;
+};
+
+Result runHeap(std::size_t nodeCount, bool materialize) {
+    Result r;
+    std::size_t heapBefore = DuiBenchHarness::heapInUse();
+    std::size_t lvglBefore = DuiBenchHarness::lvglHeapInUse();
+
+    auto start = Clock::now();
+    auto* root = new DuiVStack(DuiBenchHarness::makeRows(nodeCount));
+    r.constructMs = DuiBenchHarness::elapsedMs(start);
+    r.cppBytes = DuiBenchHarness::heapInUse() - heapBefore;
+
+    if (materialize) {
+        start = Clock::now();
+        root->_build(lv_scr_act());
+        r.buildMs = DuiBenchHarness::elapsedMs(start);
+        r.lvglBytes = DuiBenchHarness::lvglHeapInUse() - lvglBefore;
+    }
+
+    start = Clock::now();
+    delete root;
+    r.teardownMs = DuiBenchHarness::elapsedMs(start);
+    return r;
+}
+
+Result runArena(DuiArena& arena, std::size_t nodeCount, bool materialize) {
+    Result r;
+    std::size_t heapBefore = DuiBenchHarness::heapInUse();
+    std::size_t lvglBefore = DuiBenchHarness::lvglHeapInUse();
+
+    auto start = Clock::now();
+    DuiVStack* root = nullptr;
+    {
+        DuiArenaScope scope(arena);
+        root = arena.make<DuiVStack>(DuiBenchHarness::makeRows(nodeCount));
+    }
+    r.constructMs = DuiBenchHarness::elapsedMs(start);
+    r.cppBytes = DuiBenchHarness::heapInUse() - heapBefore;
+    r.arenaBytes = arena.bytesUsed();
+
+    if (materialize) {
+        start = Clock::now();
+        root->_build(lv_scr_act());
+        r.buildMs = DuiBenchHarness::elapsedMs(start);
+        r.lvglBytes = DuiBenchHarness::lvglHeapInUse() - lvglBefore;
+    }
+
+    start = Clock::now();
+    arena.reset();
+    r.teardownMs = DuiBenchHarness::elapsedMs(start);
+    return r;
+}
+
+void print(const char* mode, std::size_t nodeCount, bool materialize, const Result& r) {
+    std::printf("%s,%zu,%.3f,", mode, nodeCount, r.constructMs);
+    if (materialize) {
+        std::printf("%.3f,", r.buildMs);
+    } else {
+        std::printf("skipped,");
+    }
+    std::printf("%.3f,%zu,%zu,%zu\n", r.teardownMs, r.cppBytes, r.arenaBytes, r.lvglBytes);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t materializeLimit = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : SIZE_MAX;
+
+    LVGLApplication app;
+    if (!DuiBenchHarness::initHeadless(app)) {
+        return 1;
+    }
+
+    const std::size_t sizes[] = {1000, 3000, 10000, 30000, 100000};
+
+    std::printf("mode,nodes,construct_ms,build_ms,teardown_ms,cpp_heap_bytes,arena_bytes,lvgl_heap_bytes\n");
+    DuiArena arena;
+    for (std::size_t nodeCount : sizes) {
+        bool materialize = nodeCount <= materializeLimit;
+        print("heap", nodeCount, materialize, runHeap(nodeCount, materialize));
+        print("arena", nodeCount, materialize, runArena(arena, nodeCount, materialize));
+    }
+    return 0;
+}
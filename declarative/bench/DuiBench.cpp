@@ -0,0 +1,494 @@
+/**
+ * @file DuiBench.cpp
+ * @brief Benchmark suite of the declarative layer on a headless display
+ *
+ * Usage: dui_bench [--sizes 10,100,1000,10000,100000] [--scenario name]
+ *                  [--materialize-limit N] [--lvgl-heap-mb 256] [--format csv|json]
+ *
+ * Scenarios, each run for every size (node count):
+ *   build      construct a list of HStack(DuiText, DuiButton) rows, create the LVGL objects, render
+ *   teardown   destroy that tree again
+ *   depth      nested DuiVStack chain, size is the depth (at most 1000)
+ *   modifiers  buttons with a key/width/height/bgColor chain, then modify all of them per frame
+ *   clicks     click dispatch, per-button callbacks vs. a delegating container vs. the pointer
+ *   text       update every label per frame
+ *   grid       a four-column dashboard as rows of stacks vs. DuiGrid with fixed and fr/content tracks
+ *   names      find views by name through the registry vs. walking the tree (description only)
+ *   memory     DuiMemory accounting of a built tree against the measured heap growth, and its walk cost
+ *
+ * Every size is materialized: the LVGL heap is grown to --lvgl-heap-mb
+ * first, LV_MEM_SIZE alone holds about 3000 nodes. Sizes above
+ * --materialize-limit, unlimited by default, only build the C++
+ * description. Results go to stdout, one record per scenario, size and
+ * metric; logging goes to stderr.
+ */
+
+#include "DuiBenchHarness.h"
+#include "lvgl.h"
+#include "LVGLApplication.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include "layouts/DuiGrid.h"
+#include "components/DuiText.h"
+#include "components/DuiButton.h"
+#include "core/DuiMemory.h"
+#include "core/DuiNameTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = DuiBenchHarness::Clock;
+
+constexpr std::size_t MaxDepth = 1000;
+
+// Written by the click actions so they are not optimized away
+volatile std::size_t g_lastClicked = 0;
+
+struct Record {
+    const char* scenario;
+    std::size_t nodes;
+    std::string metric;
+    double value;
+    const char* unit;
+};
+
+std::vector<Record> g_records;
+
+void report(const char* scenario, std::size_t nodes, std::string metric, double value, const char* unit) {
+    g_records.push_back({scenario, nodes, std::move(metric), value, unit});
+}
+
+// Small trees are repeated to rise above the clock resolution
+int iterationsFor(std::size_t nodes) {
+    return static_cast<int>(std::clamp<std::size_t>(20000 / std::max<std::size_t>(nodes, 1), 1, 50));
+}
+
+void addNested(DuiChildList& add, std::size_t depth) {
+    if (depth <= 1) {
+        add(DuiText("Leaf"));
+        return;
+    }
+    add(DuiVStack([depth](DuiChildList& inner) {
+        addNested(inner, depth - 1);
+    }));
+}
+
+void benchBuild(LVGLApplication& app, std::size_t nodes, bool materialize) {
+    int iterations = iterationsFor(nodes);
+    double constructNs = 0, buildNs = 0, frameNs = 0, teardownNs = 0;
+    std::size_t cppBytes = 0, lvglBytes = 0;
+    for (int i = 0; i < iterations; ++i) {
+        DuiBenchHarness::resetPools();
+        std::size_t heapBefore = DuiBenchHarness::heapInUse();
+        std::size_t lvglBefore = DuiBenchHarness::lvglHeapInUse();
+
+        auto start = Clock::now();
+        auto root = std::make_unique<DuiVStack>(DuiBenchHarness::makeRows(nodes));
+        constructNs += DuiBenchHarness::elapsedNs(start);
+        cppBytes = DuiBenchHarness::heapInUse() - heapBefore;
+
+        if (materialize) {
+            start = Clock::now();
+            root->_build(lv_scr_act());
+            buildNs += DuiBenchHarness::elapsedNs(start);
+            lvglBytes = DuiBenchHarness::lvglHeapInUse() - lvglBefore;
+
+            start = Clock::now();
+            app.renderFrame();
+            frameNs += DuiBenchHarness::elapsedNs(start);
+        }
+
+        start = Clock::now();
+        root.reset();
+        teardownNs += DuiBenchHarness::elapsedNs(start);
+    }
+
+    report("build", nodes, "construct_ns_per_node", constructNs / iterations / nodes, "ns");
+    report("build", nodes, "cpp_bytes_per_node", static_cast<double>(cppBytes) / nodes, "bytes");
+    if (materialize) {
+        report("build", nodes, "build_ns_per_node", buildNs / iterations / nodes, "ns");
+        report("build", nodes, "first_frame_ms", frameNs / iterations / 1e6, "ms");
+        report("build", nodes, "lvgl_bytes_per_node", static_cast<double>(lvglBytes) / nodes, "bytes");
+    }
+    report("teardown", nodes, materialize ? "teardown_ns_per_node" : "description_teardown_ns_per_node",
+           teardownNs / iterations / nodes, "ns");
+}
+
+void benchDepth(LVGLApplication& app, std::size_t depth) {
+    int iterations = iterationsFor(depth);
+    double buildNs = 0, layoutNs = 0, teardownNs = 0;
+    for (int i = 0; i < iterations; ++i) {
+        DuiBenchHarness::resetPools();
+        auto start = Clock::now();
+        auto root = std::make_unique<DuiVStack>([depth](DuiChildList& add) {
+            addNested(add, depth - 1);
+        });
+        root->_build(lv_scr_act());
+        buildNs += DuiBenchHarness::elapsedNs(start);
+
+        start = Clock::now();
+        app.renderFrame();
+        layoutNs += DuiBenchHarness::elapsedNs(start);
+
+        start = Clock::now();
+        root.reset();
+        teardownNs += DuiBenchHarness::elapsedNs(start);
+    }
+    report("depth", depth, "build_ms", buildNs / iterations / 1e6, "ms");
+    report("depth", depth, "first_frame_ms", layoutNs / iterations / 1e6, "ms");
+    report("depth", depth, "teardown_ms", teardownNs / iterations / 1e6, "ms");
+}
+
+void benchModifiers(LVGLApplication& app, std::size_t nodes) {
+    DuiBenchHarness::resetPools();
+    const lv_color_t colors[] = {lv_palette_main(LV_PALETTE_GREEN), lv_palette_main(LV_PALETTE_RED)};
+
+    auto start = Clock::now();
+    DuiVStack root([nodes, &colors](DuiChildList& add) {
+        for (std::size_t i = 0; i < nodes; ++i) {
+            add(DuiButton("B").key(std::to_string(i)).width(100).height(30).bgColor(colors[0]));
+        }
+    });
+    double constructNs = DuiBenchHarness::elapsedNs(start);
+    root._build(lv_scr_act());
+    app.renderFrame();
+
+    // Change two properties of every button, committed in one batch by the next frame
+    const int rounds = 10;
+    double updateNs = 0, commitNs = 0;
+    for (int round = 0; round < rounds; ++round) {
+        start = Clock::now();
+        for (std::size_t i = 0; i < nodes; ++i) {
+            static_cast<DuiButton*>(root.childAt(i))->width(100 + round % 2).bgColor(colors[round % 2]);
+        }
+        updateNs += DuiBenchHarness::elapsedNs(start);
+
+        start = Clock::now();
+        app.renderFrame();
+        commitNs += DuiBenchHarness::elapsedNs(start);
+    }
+    report("modifiers", nodes, "construct_ns_per_node", constructNs / nodes, "ns");
+    report("modifiers", nodes, "update_ns_per_node", updateNs / rounds / nodes, "ns");
+    report("modifiers", nodes, "commit_frame_ms", commitNs / rounds / 1e6, "ms");
+}
+
+void benchClicks(LVGLApplication& app, std::size_t nodes) {
+    for (bool delegated : {false, true}) {
+        DuiBenchHarness::resetPools();
+        DuiVStack root([nodes](DuiChildList& add) {
+            for (std::size_t i = 0; i < nodes; ++i) {
+                add(DuiButton("B").onClick([i] { g_lastClicked = i; }));
+            }
+        });
+        if (delegated) {
+            root.delegateEvents();
+        }
+        root._build(lv_scr_act());
+        app.renderFrame();
+
+        // Click every button a few times, through LVGL's own event dispatch
+        const int rounds = std::max(1, iterationsFor(nodes) / 5);
+        auto start = Clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < nodes; ++i) {
+                lv_obj_send_event(root.childAt(i)->lvObject(), LV_EVENT_CLICKED, nullptr);
+            }
+        }
+        double dispatchNs = DuiBenchHarness::elapsedNs(start) / (rounds * nodes);
+        report("clicks", nodes, delegated ? "dispatch_ns_delegated" : "dispatch_ns_per_button", dispatchNs, "ns");
+
+        if (delegated) {
+            // Press and release on the first button through the virtual pointer: hit test included
+            lv_area_t area;
+            lv_obj_get_coords(root.childAt(0)->lvObject(), &area);
+            const int clicks = 1000;
+            start = Clock::now();
+            for (int i = 0; i < clicks; ++i) {
+                app.injectClick((area.x1 + area.x2) / 2, (area.y1 + area.y2) / 2);
+            }
+            report("clicks", nodes, "pointer_click_ns", DuiBenchHarness::elapsedNs(start) / clicks, "ns");
+        }
+    }
+}
+
+void benchText(LVGLApplication& app, std::size_t nodes) {
+    DuiBenchHarness::resetPools();
+    DuiVStack root([nodes](DuiChildList& add) {
+        for (std::size_t i = 0; i < nodes; ++i) {
+            add(DuiText("0"));
+        }
+    });
+    root._build(lv_scr_act());
+    app.renderFrame();
+
+    const int rounds = 20;
+    double updateNs = 0, frameNs = 0;
+    for (int round = 0; round < rounds; ++round) {
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < nodes; ++i) {
+            static_cast<DuiText*>(root.childAt(i))->format("%d km/h", round * 7 + static_cast<int>(i));
+        }
+        updateNs += DuiBenchHarness::elapsedNs(start);
+
+        start = Clock::now();
+        app.renderFrame();
+        frameNs += DuiBenchHarness::elapsedNs(start);
+    }
+    report("text", nodes, "update_ns_per_text", updateNs / rounds / nodes, "ns");
+    report("text", nodes, "frame_ms", frameNs / rounds / 1e6, "ms");
+    report("text", nodes, "updates_per_s", rounds * nodes / ((updateNs + frameNs) / 1e9), "1/s");
+}
+
+std::size_t countObjects(lv_obj_t* obj) {
+    std::size_t count = 1;
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); ++i) {
+        count += countObjects(lv_obj_get_child(obj, i));
+    }
+    return count;
+}
+
+// The same cells three ways: what a dashboard built from stacks needs, and
+// a grid with a fixed template (no layout) or an fr/content one (LVGL grid)
+void benchGrid(LVGLApplication& app, std::size_t cells) {
+    const std::size_t columns = 4;
+    std::size_t rows = (cells + columns - 1) / columns;
+    const char* methods[] = {"stacks", "grid_fixed", "grid_fr"};
+    for (int method = 0; method < 3; ++method) {
+        DuiBenchHarness::resetPools();
+        auto start = Clock::now();
+        DuiNodePtr root;
+        if (method == 0) {
+            root = DuiArena::makeNode(DuiVStack([cells, rows](DuiChildList& add) {
+                for (std::size_t row = 0; row < rows; ++row) {
+                    DuiHStack line;
+                    for (std::size_t column = 0; column < columns && row * columns + column < cells; ++column) {
+                        line.addChild(DuiText("Cell " + std::to_string(row * columns + column)).width(150));
+                    }
+                    add(std::move(line));
+                }
+            }));
+        } else {
+            bool fixed = method == 1;
+            std::vector<DuiGridTrack> columnTracks(columns, fixed ? DuiGridTrack::fixed(150) : DuiGridTrack::fr(1));
+            std::vector<DuiGridTrack> rowTracks(rows, fixed ? DuiGridTrack::fixed(40) : DuiGridTrack::content());
+            root = DuiArena::makeNode(DuiGrid(columnTracks, rowTracks, [cells](DuiGridChildList& add) {
+                for (std::size_t i = 0; i < cells; ++i) {
+                    add(DuiText("Cell " + std::to_string(i)));
+                }
+            }));
+        }
+        lv_obj_t* obj = root->_build(lv_scr_act());
+        double buildNs = DuiBenchHarness::elapsedNs(start);
+
+        start = Clock::now();
+        lv_obj_update_layout(obj);
+        double layoutNs = DuiBenchHarness::elapsedNs(start);
+
+        // One value changes its width, as a live dashboard does every frame
+        const int rounds = 20;
+        lv_obj_t* label = obj;
+        while (lv_obj_get_child_count(label)) {
+            label = lv_obj_get_child(label, 0);
+        }
+        start = Clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            lv_label_set_text_static(label, round % 2 ? "1" : "1024.5 kPa");
+            lv_obj_update_layout(obj);
+        }
+        double relayoutNs = DuiBenchHarness::elapsedNs(start) / rounds;
+
+        std::string prefix = methods[method];
+        report("grid", cells, prefix + "_objects", static_cast<double>(countObjects(obj)), "count");
+        report("grid", cells, prefix + "_build_ns_per_cell", buildNs / cells, "ns");
+        report("grid", cells, prefix + "_layout_us", layoutNs / 1e3, "us");
+        report("grid", cells, prefix + "_relayout_us", relayoutNs / 1e3, "us");
+
+        root.reset();
+        app.renderFrame();
+    }
+}
+
+// Named labels looked up the way test automation and data bindings do
+void benchNames(std::size_t nodes) {
+    std::vector<std::string> names(nodes);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        names[i] = "value" + std::to_string(i);
+    }
+    auto start = Clock::now();
+    DuiVStack root([&names](DuiChildList& add) {
+        for (const std::string& name : names) {
+            add(DuiText("0").objectName(name));
+        }
+    });
+    double constructNs = DuiBenchHarness::elapsedNs(start);
+
+    const std::size_t lookups = 100000;
+    std::size_t found = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) {
+        found += DuiObject::findByName(names[i * 7919 % nodes]) != nullptr;
+    }
+    double byNameNs = DuiBenchHarness::elapsedNs(start) / lookups;
+
+    std::vector<uint32_t> ids(nodes);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        ids[i] = DuiNameTable::find(names[i]);
+    }
+    start = Clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) {
+        found += DuiObject::findByNameId(ids[i * 7919 % nodes]) != nullptr;
+    }
+    double byIdNs = DuiBenchHarness::elapsedNs(start) / lookups;
+
+    // Without the registry: compare the name of every child until it matches
+    std::size_t walks = std::clamp<std::size_t>(1000000 / nodes, 1, lookups);
+    start = Clock::now();
+    for (std::size_t i = 0; i < walks; ++i) {
+        const std::string& name = names[i * 7919 % nodes];
+        for (std::size_t child = 0; child < root.childCount(); ++child) {
+            if (root.childAt(child)->objectName() == name) {
+                ++found;
+                break;
+            }
+        }
+    }
+    double walkNs = DuiBenchHarness::elapsedNs(start) / walks;
+    if (found != 2 * lookups + walks) {
+        std::cerr << "names: " << 2 * lookups + walks - found << " lookups failed" << std::endl;
+    }
+
+    report("names", nodes, "construct_ns_per_node", constructNs / nodes, "ns");
+    report("names", nodes, "find_by_name_ns", byNameNs, "ns");
+    report("names", nodes, "find_by_id_ns", byIdNs, "ns");
+    report("names", nodes, "tree_walk_ns", walkNs, "ns");
+}
+
+void benchMemory(LVGLApplication& app, std::size_t nodes) {
+    DuiBenchHarness::resetPools();
+    std::size_t heapBefore = DuiBenchHarness::heapInUse();
+    std::size_t lvglBefore = DuiBenchHarness::lvglHeapInUse();
+    auto root = std::make_unique<DuiVStack>(DuiBenchHarness::makeRows(nodes));
+    root->_build(lv_scr_act());
+    std::size_t cppMeasured = DuiBenchHarness::heapInUse() - heapBefore;
+    std::size_t lvglMeasured = DuiBenchHarness::lvglHeapInUse() - lvglBefore;
+    app.renderFrame();
+
+    const int rounds = 20;
+    DuiMemoryReport memory;
+    auto start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        memory = DuiMemory::measure(*root);
+    }
+    double measureNs = DuiBenchHarness::elapsedNs(start) / rounds;
+
+    std::size_t views = memory.total.nodes;
+    report("memory", nodes, "accounted_cpp_bytes_per_node", static_cast<double>(memory.total.cppBytes) / views, "bytes");
+    report("memory", nodes, "accounted_lvgl_bytes_per_node", static_cast<double>(memory.total.lvglBytes) / views,
+           "bytes");
+    // Allocator headers and untracked allocations make up the difference
+    if (cppMeasured) {
+        report("memory", nodes, "cpp_coverage_pct", 100.0 * memory.total.cppBytes / cppMeasured, "%");
+    }
+    if (lvglMeasured) {
+        report("memory", nodes, "lvgl_coverage_pct", 100.0 * memory.total.lvglBytes / lvglMeasured, "%");
+    }
+    report("memory", nodes, "measure_ns_per_node", measureNs / views, "ns");
+}
+
+void printCsv() {
+    std::printf("scenario,nodes,metric,value,unit\n");
+    for (const Record& r : g_records) {
+        std::printf("%s,%zu,%s,%.3f,%s\n", r.scenario, r.nodes, r.metric.c_str(), r.value, r.unit);
+    }
+}
+
+void printJson() {
+    std::printf("{\"lvgl\":\"%d.%d.%d\",\"results\":[", LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH);
+    for (std::size_t i = 0; i < g_records.size(); ++i) {
+        const Record& r = g_records[i];
+        std::printf("%s\n{\"scenario\":\"%s\",\"nodes\":%zu,\"metric\":\"%s\",\"value\":%.3f,\"unit\":\"%s\"}",
+                    i ? "," : "", r.scenario, r.nodes, r.metric.c_str(), r.value, r.unit);
+    }
+    std::printf("\n]}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> sizes = {10, 100, 1000, 10000, 100000};
+    std::size_t materializeLimit = SIZE_MAX;
+    std::size_t lvglHeapBytes = DuiBenchHarness::DefaultLvglHeapBytes;
+    const char* scenario = nullptr;
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            sizes = DuiBenchHarness::parseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            scenario = argv[++i];
+        } else if (std::strcmp(argv[i], "--materialize-limit") == 0 && i + 1 < argc) {
+            materializeLimit = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--lvgl-heap-mb") == 0 && i + 1 < argc) {
+            lvglHeapBytes = std::size_t(std::strtoul(argv[++i], nullptr, 10)) << 20;
+        } else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            json = std::strcmp(argv[++i], "json") == 0;
+        }
+    }
+    auto selected = [scenario](const char* name) {
+        return !scenario || std::strcmp(scenario, name) == 0 ||
+               (std::strcmp(scenario, "teardown") == 0 && std::strcmp(name, "build") == 0);
+    };
+
+    LVGLApplication app;
+    if (!DuiBenchHarness::initHeadless(app, 800, 480, lvglHeapBytes)) {
+        return 1;
+    }
+
+    for (std::size_t nodes : sizes) {
+        bool materialize = nodes <= materializeLimit;
+        std::cerr << "size " << nodes << (materialize ? "" : " (description only)") << std::endl;
+        if (selected("build")) {
+            benchBuild(app, nodes, materialize);
+        }
+        if (selected("names")) {
+            benchNames(nodes);
+        }
+        if (!materialize) {
+            continue;
+        }
+        if (selected("depth") && nodes <= MaxDepth) {
+            benchDepth(app, nodes);
+        }
+        if (selected("modifiers")) {
+            benchModifiers(app, nodes);
+        }
+        if (selected("clicks")) {
+            benchClicks(app, nodes);
+        }
+        if (selected("text")) {
+            benchText(app, nodes);
+        }
+        if (selected("grid")) {
+            benchGrid(app, nodes);
+        }
+        if (selected("memory")) {
+            benchMemory(app, nodes);
+        }
+    }
+    DuiBenchHarness::resetPools();
+
+    if (json) {
+        printJson();
+    } else {
+        printCsv();
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "DuiBenchHarness.h"
+#include "layouts/DuiHStack.h"
+#include "components/DuiText.h"
+#include "components/DuiButton.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+bool DuiBenchHarness::initHeadless(LVGLApplication& app, int32_t width, int32_t height, std::size_t lvglHeapBytes) {
+    keepStdoutForResults();
+
+    HeadlessConfig headless;
+    headless.width = width;
+    headless.height = height;
+    if (!app.initializeHeadless(headless)) {
+        return false;
+    }
+    std::size_t heap = growLvglHeap(lvglHeapBytes);
+    if (heap < lvglHeapBytes) {
+        std::cerr << "LVGL heap limited to " << (heap >> 20) << " MiB" << std::endl;
+    }
+    return true;
+}
+
+void DuiBenchHarness::keepStdoutForResults() {
+    std::cout.rdbuf(std::cerr.rdbuf());
+}
+
+std::size_t DuiBenchHarness::growLvglHeap(std::size_t bytes) {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    std::size_t total = mon.total_size;
+    // TLSF is configured for blocks of at most LV_MEM_SIZE, so the heap grows
+    // by pools of that size
+    while (total < bytes) {
+        void* chunk = std::malloc(LV_MEM_SIZE);
+        if (!chunk) {
+            break;
+        }
+        if (!lv_mem_add_pool(chunk, LV_MEM_SIZE)) {
+            std::free(chunk);
+            break;
+        }
+        total += LV_MEM_SIZE;
+    }
+    return total;
+#else
+    // lv_malloc is the system allocator
+    return bytes;
+#endif
+}
+
+double DuiBenchHarness::elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+double DuiBenchHarness::elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+double DuiBenchHarness::elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::size_t DuiBenchHarness::heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+std::size_t DuiBenchHarness::lvglHeapInUse() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+std::vector<std::size_t> DuiBenchHarness::parseList(const char* list) {
+    std::vector<std::size_t> values;
+    for (const char* p = list; *p;) {
+        char* end = nullptr;
+        std::size_t value = std::strtoul(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+        if (value) {
+            values.push_back(value);
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+    return values;
+}
+
+void DuiBenchHarness::resetPools() {
+    DuiText::pool().clear();
+    DuiButton::pool().clear();
+}
+
+DuiVStack DuiBenchHarness::makeRows(std::size_t nodes) {
+    return DuiVStack([nodes](DuiChildList& add) {
+        for (std::size_t i = 0; i + 3 <= std::max<std::size_t>(nodes, 3); i += 3) {
+            add(DuiHStack(
+                DuiText("Row " + std::to_string(i / 3)),
+                DuiButton("Open")));
+        }
+    });
+}
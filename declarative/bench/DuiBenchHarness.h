@@ -0,0 +1,57 @@
+/**
+ * @file DuiBenchHarness.h
+ * @brief Setup, timing and memory helpers shared by the declarative benchmarks
+ */
+
+#pragma once
+
+#include "lvgl.h"
+#include "LVGLApplication.h"
+#include "layouts/DuiVStack.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class DuiBenchHarness {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // LVGL heap a headless benchmark runs with, enough for 100k materialized nodes
+    static constexpr std::size_t DefaultLvglHeapBytes = std::size_t(256) << 20;
+
+    /**
+     * Initialize app on a headless display and grow the LVGL heap to
+     * lvglHeapBytes. stdout is kept for the results, the application's log
+     * goes to stderr.
+     */
+    static bool initHeadless(LVGLApplication& app, int32_t width = 800, int32_t height = 480,
+                             std::size_t lvglHeapBytes = DefaultLvglHeapBytes);
+
+    // LVGLApplication logs to std::cout, send it to stderr instead
+    static void keepStdoutForResults();
+
+    /**
+     * Add memory to the builtin LVGL heap until it holds at least bytes.
+     * LV_MEM_SIZE suits the device, not a 100k-node benchmark; the added
+     * chunks stay until exit. Returns the heap size reached.
+     */
+    static std::size_t growLvglHeap(std::size_t bytes);
+
+    static double elapsedNs(Clock::time_point start);
+    static double elapsedUs(Clock::time_point start);
+    static double elapsedMs(Clock::time_point start);
+
+    // Bytes in use on the C++ heap (glibc), 0 where it cannot be read
+    static std::size_t heapInUse();
+    static std::size_t lvglHeapInUse();
+
+    // "10,100,1000": the non-zero values of a comma separated list
+    static std::vector<std::size_t> parseList(const char* list);
+
+    // Parked objects would turn later builds into pool hits, every run starts cold
+    static void resetPools();
+
+    // A list of rows, each HStack(DuiText, DuiButton): three nodes per row
+    static DuiVStack makeRows(std::size_t nodes);
+};
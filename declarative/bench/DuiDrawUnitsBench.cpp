@@ -0,0 +1,117 @@
+/**
+ * @file DuiDrawUnitsBench.cpp
+ * @brief Full-frame render time with 1..N software draw units
+ *
+ * Usage: DuiDrawUnitsBench [frames]
+ * Build with -DLV_USE_PTHREAD=ON -DLV_DRAW_SW_DRAW_UNIT_CNT=N; the units
+ * compiled in are enabled one by one with DrawUnits::setActive(). Prints
+ * one CSV row per scenario and unit count.
+ */
+
+#include "DuiBenchHarness.h"
+#include "lvgl.h"
+#include "demos/lv_demos.h"
+#include "DrawUnits.h"
+#include "LVGLApplication.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include "components/DuiText.h"
+#include "components/DuiButton.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = DuiBenchHarness::Clock;
+
+// Rows of labels and themed buttons (radius, shadow), redrawn in full every frame
+DuiVStack makeHeavyScreen() {
+    return DuiVStack([](DuiChildList& add) {
+        for (int row = 0; row < 40; ++row) {
+            add(DuiHStack(
+                DuiText("Row " + std::to_string(row)).width(120),
+                DuiButton("Start").bgColor(lv_palette_main(LV_PALETTE_GREEN)),
+                DuiButton("Stop").bgColor(lv_palette_main(LV_PALETTE_RED)),
+                DuiText("Status: idle")));
+        }
+    });
+}
+
+struct Result {
+    double avgMs = 0;
+    double p95Ms = 0;
+};
+
+Result measure(lv_display_t* disp, lv_obj_t* screen, int frames) {
+    std::vector<double> samples;
+    samples.reserve(frames);
+    for (int i = 0; i < frames + 5; ++i) {
+        lv_obj_invalidate(screen);
+        auto start = Clock::now();
+        lv_refr_now(disp);
+        double ms = DuiBenchHarness::elapsedMs(start);
+        // The first frames warm up caches and layout
+        if (i >= 5) {
+            samples.push_back(ms);
+        }
+    }
+    Result r;
+    for (double ms : samples) {
+        r.avgMs += ms;
+    }
+    r.avgMs /= samples.size();
+    std::sort(samples.begin(), samples.end());
+    r.p95Ms = samples[samples.size() * 95 / 100];
+    return r;
+}
+
+void runScenario(const char* name, lv_display_t* disp, lv_obj_t* screen, int frames) {
+    lv_screen_load(screen);
+    double baseline = 0;
+    for (uint32_t units = 1; units <= DrawUnits::available(); ++units) {
+        DrawUnits::setActive(units);
+        Result r = measure(disp, screen, frames);
+        if (units == 1) {
+            baseline = r.avgMs;
+        }
+        std::printf("%s,%u,%.3f,%.3f,%.2f\n", name, units, r.avgMs, r.p95Ms, baseline / r.avgMs);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 60;
+    if (frames < 1) {
+        std::fprintf(stderr, "usage: DuiDrawUnitsBench [frames >= 1]\n");
+        return 1;
+    }
+
+    // The headless display renders into one full-size buffer, so a frame is
+    // a single layer the units can split up
+    LVGLApplication app;
+    if (!DuiBenchHarness::initHeadless(app)) {
+        return 1;
+    }
+    lv_display_t* disp = app.getDisplay();
+
+    std::printf("scenario,draw_units,frame_ms,frame_p95_ms,speedup\n");
+
+#if LV_USE_DEMO_WIDGETS
+    lv_obj_t* widgets = lv_screen_active();
+    lv_demo_widgets();
+    runScenario("widgets", disp, widgets, frames);
+#endif
+
+    lv_obj_t* duiScreen = lv_obj_create(nullptr);
+    DuiVStack heavy = makeHeavyScreen();
+    heavy._build(duiScreen);
+    runScenario("dui", disp, duiScreen, frames);
+
+    DrawUnits::setActive(0);
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file DuiEventBench.cpp
+ * @brief Memory and cost of click handling, one callback per button vs. a delegating container
+ *
+ * Usage: DuiEventBench
+ * Prints one CSV row per mode and button count.
+ */
+
+#include "DuiBenchHarness.h"
+#include "lvgl.h"
+#include "LVGLApplication.h"
+#include "core/DuiEventDelegate.h"
+#include "layouts/DuiVStack.h"
+#include "components/DuiButton.h"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+using Clock = DuiBenchHarness::Clock;
+
+// Written by the click actions so they are not optimized away
+volatile std::size_t g_lastClicked = 0;
+
+struct Result {
+    double buildMs = 0;
+    double dispatchNs = 0;
+    std::size_t cppBytes = 0;
+    std::size_t lvglBytes = 0;
+};
+
+Result run(std::size_t buttonCount, bool delegated) {
+    Result r;
+    std::size_t heapBefore = DuiBenchHarness::heapInUse();
+    std::size_t lvglBefore = DuiBenchHarness::lvglHeapInUse();
+
+    auto start = Clock::now();
+    DuiVStack root([buttonCount](DuiChildList& add) {
+        for (std::size_t i = 0; i < buttonCount; ++i) {
+            add(DuiButton("B").onClick([i] { g_lastClicked = i; }));
+        }
+    });
+    if (delegated) {
+        root.delegateEvents();
+    }
+    root._build(lv_scr_act());
+    r.buildMs = DuiBenchHarness::elapsedMs(start);
+    r.cppBytes = DuiBenchHarness::heapInUse() - heapBefore;
+    r.lvglBytes = DuiBenchHarness::lvglHeapInUse() - lvglBefore;
+
+    // Click every button a few times, through LVGL's own event dispatch
+    const int rounds = 10;
+    start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < buttonCount; ++i) {
+            lv_obj_send_event(root.childAt(i)->lvObject(), LV_EVENT_CLICKED, nullptr);
+        }
+    }
+    r.dispatchNs = DuiBenchHarness::elapsedMs(start) * 1e6 / (rounds * buttonCount);
+    return r;
+}
+
+} // namespace
+
+int main() {
+    LVGLApplication app;
+    if (!DuiBenchHarness::initHeadless(app)) {
+        return 1;
+    }
+
+    const std::size_t sizes[] = {100, 500, 2000};
+
+    std::printf("mode,buttons,build_ms,dispatch_ns,cpp_bytes_per_button,lvgl_bytes_per_button\n");
+    for (std::size_t buttonCount : sizes) {
+        for (bool delegated : {false, true}) {
+            Result r = run(buttonCount, delegated);
+            std::printf("%s,%zu,%.3f,%.1f,%zu,%zu\n", delegated ? "delegated" : "per_button", buttonCount, r.buildMs,
+                        r.dispatchNs, r.cppBytes / buttonCount, r.lvglBytes / buttonCount);
+        }
+    }
+    return 0;
+}
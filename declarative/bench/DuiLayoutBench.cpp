@@ -0,0 +1,162 @@
+/**
+ * @file DuiLayoutBench.cpp
+ * @brief Layout time of nested stacks, LVGL flex vs. the native DuiStackLayout
+ *
+ * Usage: DuiLayoutBench [--depths 1,2,5,10,15,20] [--rounds 200]
+ *
+ * For each depth a chain of stacks is nested that deep, alternating
+ * DuiVStack and DuiHStack, each level holding three labels and the next
+ * level. The same tree is built once with flex and once with
+ * .nativeLayout() on every stack, and timed on a headless display:
+ *   first_layout_us  the first lv_obj_update_layout() of the new tree
+ *   leaf_us          relayout after the text (and size) of the deepest label changed
+ *   resize_us        relayout after the width of the outermost stack changed
+ * moves_per_round counts the children the native pass moved per change.
+ * Both layouts must place every object at the same coordinates; a
+ * mismatch is reported on stderr. Prints one CSV row per depth and layout.
+ */
+
+#include "DuiBenchHarness.h"
+#include "lvgl.h"
+#include "LVGLApplication.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include "layouts/DuiStackLayout.h"
+#include "components/DuiText.h"
+#include "core/DuiFlushQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = DuiBenchHarness::Clock;
+
+// Three labels and the next level; leaf receives the deepest label
+template<typename Stack>
+DuiNodePtr makeStack(std::size_t depth, bool native, DuiText*& leaf, std::size_t& nodes);
+
+DuiNodePtr makeLevel(std::size_t depth, bool native, DuiText*& leaf, std::size_t& nodes) {
+    return depth % 2 ? makeStack<DuiVStack>(depth, native, leaf, nodes)
+                     : makeStack<DuiHStack>(depth, native, leaf, nodes);
+}
+
+template<typename Stack>
+DuiNodePtr makeStack(std::size_t depth, bool native, DuiText*& leaf, std::size_t& nodes) {
+    Stack stack;
+    if (native) {
+        stack.nativeLayout();
+    }
+    for (int i = 0; i < 3; ++i) {
+        stack.addChild(DuiText("Level " + std::to_string(depth) + " item " + std::to_string(i)));
+    }
+    leaf = static_cast<DuiText*>(stack.childAt(0));
+    nodes += 4;
+    if (depth > 1) {
+        stack.addChild(makeLevel(depth - 1, native, leaf, nodes));
+    }
+    return DuiArena::makeNode(std::move(stack));
+}
+
+// Coordinates of every object in the subtree, in tree order
+void collectCoords(lv_obj_t* obj, std::vector<lv_area_t>& out) {
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    out.push_back(area);
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); ++i) {
+        collectCoords(lv_obj_get_child(obj, i), out);
+    }
+}
+
+struct Result {
+    std::size_t nodes = 0;
+    double firstLayoutUs = 0;
+    double leafUs = 0;
+    double resizeUs = 0;
+    double movesPerRound = 0;
+    std::vector<lv_area_t> coords;
+};
+
+Result run(LVGLApplication& app, std::size_t depth, bool native, int rounds) {
+    Result result;
+    DuiText* leaf = nullptr;
+    DuiNodePtr root = makeLevel(depth, native, leaf, result.nodes);
+    lv_obj_t* obj = root->_build(lv_scr_act());
+
+    auto start = Clock::now();
+    lv_obj_update_layout(obj);
+    result.firstLayoutUs = DuiBenchHarness::elapsedUs(start);
+    collectCoords(obj, result.coords);
+
+    DuiStackLayout::resetStats();
+    for (int round = 0; round < rounds; ++round) {
+        leaf->setText(round % 2 ? "Deepest" : "Deepest label, now longer");
+        DuiFlushQueue::flush();
+        start = Clock::now();
+        lv_obj_update_layout(obj);
+        result.leafUs += DuiBenchHarness::elapsedUs(start);
+    }
+    for (int round = 0; round < rounds; ++round) {
+        lv_obj_set_width(obj, round % 2 ? LV_PCT(100) : LV_PCT(90));
+        start = Clock::now();
+        lv_obj_update_layout(obj);
+        result.resizeUs += DuiBenchHarness::elapsedUs(start);
+    }
+    result.leafUs /= rounds;
+    result.resizeUs /= rounds;
+    result.movesPerRound = static_cast<double>(DuiStackLayout::stats().moves) / (2 * rounds);
+
+    root.reset();
+    // Deleted objects are freed with the next refresh
+    app.renderFrame();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> depths = {1, 2, 5, 10, 15, 20};
+    int rounds = 200;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--depths") == 0 && i + 1 < argc) {
+            depths = DuiBenchHarness::parseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        }
+    }
+
+    LVGLApplication app;
+    if (!DuiBenchHarness::initHeadless(app)) {
+        return 1;
+    }
+
+    std::printf("depth,nodes,layout,first_layout_us,leaf_us,resize_us,moves_per_round\n");
+    for (std::size_t depth : depths) {
+        Result flex = run(app, depth, false, rounds);
+        Result native = run(app, depth, true, rounds);
+
+        std::size_t mismatches = flex.coords.size() == native.coords.size() ? 0 : flex.coords.size();
+        for (std::size_t i = 0; !mismatches && i < flex.coords.size(); ++i) {
+            const lv_area_t& a = flex.coords[i];
+            const lv_area_t& b = native.coords[i];
+            if (a.x1 != b.x1 || a.y1 != b.y1 || a.x2 != b.x2 || a.y2 != b.y2) {
+                ++mismatches;
+            }
+        }
+        if (mismatches) {
+            std::cerr << "depth " << depth << ": native layout differs from flex" << std::endl;
+        }
+
+        for (const Result* r : {&flex, &native}) {
+            std::printf("%zu,%zu,%s,%.1f,%.2f,%.2f,%.1f\n", depth, r->nodes, r == &flex ? "flex" : "native",
+                        r->firstLayoutUs, r->leafUs, r->resizeUs, r == &flex ? 0.0 : r->movesPerRound);
+        }
+        std::fflush(stdout);
+    }
+    return 0;
+}
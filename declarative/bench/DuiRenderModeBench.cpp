@@ -0,0 +1,127 @@
+/**
+ * @file DuiRenderModeBench.cpp
+ * @brief Frame, flush and pixel-copy cost of the SDL display's render modes
+ *
+ * Usage: DuiRenderModeBench [frames] [width] [height]
+ * Opens an SDL window (a window system or Xvfb is needed) and switches its
+ * buffering with LVGLApplication::applyDisplayConfig() between runs. Each
+ * configuration renders a full redraw and a small update (one label) per
+ * frame. Prints one CSV row per configuration and scenario.
+ */
+
+#include "DuiBenchHarness.h"
+#include "lvgl.h"
+#include "LVGLApplication.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include "components/DuiText.h"
+#include "components/DuiButton.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+// Rows of labels and themed buttons, like DuiDrawUnitsBench
+DuiVStack makeScreen() {
+    return DuiVStack([](DuiChildList& add) {
+        for (int row = 0; row < 40; ++row) {
+            add(DuiHStack(
+                DuiText("Row " + std::to_string(row)).width(120),
+                DuiButton("Start").bgColor(lv_palette_main(LV_PALETTE_GREEN)),
+                DuiText("Status: idle")));
+        }
+    });
+}
+
+const char* modeName(lv_display_render_mode_t mode) {
+    switch (mode) {
+    case LV_DISPLAY_RENDER_MODE_PARTIAL:
+        return "partial";
+    case LV_DISPLAY_RENDER_MODE_FULL:
+        return "full";
+    default:
+        return "direct";
+    }
+}
+
+const char* formatName(lv_color_format_t format) {
+    switch (format) {
+    case LV_COLOR_FORMAT_RGB565:
+        return "rgb565";
+    case LV_COLOR_FORMAT_RGB888:
+        return "rgb888";
+    default:
+        return "native";
+    }
+}
+
+void printRow(const DisplayConfig& config, const char* scenario, const FrameStats& f, int frames) {
+    double perFrame = frames > 0 ? 1000.0 * frames : 1;
+    std::printf("%s,%u,%u,%s,%llu,%s,%.3f,%.3f,%.3f,%llu\n", modeName(config.renderMode), config.bufferCount,
+                config.bufferLines, formatName(config.colorFormat),
+                static_cast<unsigned long long>(f.bufferBytes / 1024), scenario, f.refreshUs / perFrame,
+                f.flushUs / perFrame, f.copyUs / perFrame,
+                static_cast<unsigned long long>(frames ? f.copiedPixels / frames : 0));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 60;
+    int32_t width = argc > 2 ? std::atoi(argv[2]) : 800;
+    int32_t height = argc > 3 ? std::atoi(argv[3]) : 480;
+
+    DuiBenchHarness::keepStdoutForResults();
+
+    LVGLApplication app;
+    DisplayConfig initial;
+    initial.width = width;
+    initial.height = height;
+    if (!app.initialize(initial)) {
+        return 1;
+    }
+
+    DuiVStack screen = makeScreen();
+    screen._build(lv_scr_act());
+    auto* status = static_cast<DuiText*>(static_cast<DuiHStack*>(screen.childAt(0))->childAt(2));
+
+    const DisplayConfig configs[] = {
+        {width, height, LV_DISPLAY_RENDER_MODE_PARTIAL, 1, 40, LV_COLOR_FORMAT_NATIVE},
+        {width, height, LV_DISPLAY_RENDER_MODE_PARTIAL, 2, 40, LV_COLOR_FORMAT_NATIVE},
+        {width, height, LV_DISPLAY_RENDER_MODE_PARTIAL, 1, 0, LV_COLOR_FORMAT_NATIVE},
+        {width, height, LV_DISPLAY_RENDER_MODE_PARTIAL, 1, 40, LV_COLOR_FORMAT_RGB565},
+        {width, height, LV_DISPLAY_RENDER_MODE_DIRECT, 1, 0, LV_COLOR_FORMAT_NATIVE},
+        {width, height, LV_DISPLAY_RENDER_MODE_DIRECT, 2, 0, LV_COLOR_FORMAT_NATIVE},
+        {width, height, LV_DISPLAY_RENDER_MODE_DIRECT, 1, 0, LV_COLOR_FORMAT_RGB565},
+        {width, height, LV_DISPLAY_RENDER_MODE_DIRECT, 1, 0, LV_COLOR_FORMAT_RGB888},
+        {width, height, LV_DISPLAY_RENDER_MODE_FULL, 1, 0, LV_COLOR_FORMAT_NATIVE},
+        {width, height, LV_DISPLAY_RENDER_MODE_FULL, 2, 0, LV_COLOR_FORMAT_NATIVE},
+    };
+
+    std::printf("mode,buffers,lines,format,buffer_kib,scenario,frame_ms,flush_ms,copy_ms,copied_px_per_frame\n");
+    for (const DisplayConfig& config : configs) {
+        if (!app.applyDisplayConfig(config)) {
+            continue;
+        }
+        // Warm up: the first frames after a switch redraw everything into the new buffers
+        for (int i = 0; i < 5; ++i) {
+            app.renderFrame();
+        }
+
+        app.resetFrameStats();
+        for (int i = 0; i < frames; ++i) {
+            lv_obj_invalidate(lv_scr_act());
+            app.renderFrame();
+        }
+        printRow(config, "full_redraw", app.frameStats(), frames);
+
+        app.resetFrameStats();
+        for (int i = 0; i < frames; ++i) {
+            status->format("Status: %d", i);
+            app.renderFrame();
+        }
+        printRow(config, "label_update", app.frameStats(), frames);
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file DuiSnapshotBench.cpp
+ * @brief Load time of a screen from a snapshot file vs. running the view constructors
+ *
+ * Usage: DuiSnapshotBench [--sizes 30,300,3000,10000] [--materialize-limit N]
+ *                         [--file /tmp/dui_snapshot_bench.snap]
+ *
+ * For each size (node count) a list of HStack(DuiText, DuiButton) rows is
+ * written to a snapshot file once. Each run then creates the same screen on
+ * a headless display in three ways:
+ *   constructors  describe: DuiVStack description;   materialize: _build()
+ *   views         describe: load() (mmap) + build(); materialize: _build()
+ *   objects       describe: load() (mmap);           materialize: instantiate()
+ * and renders the first frame. Sizes above the materialize limit,
+ * unlimited by default, only measure the description. Prints one CSV row
+ * per size and method.
+ */
+
+#include "DuiBenchHarness.h"
+#include "lvgl.h"
+#include "LVGLApplication.h"
+#include "core/DuiSnapshot.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include "components/DuiText.h"
+#include "components/DuiButton.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = DuiBenchHarness::Clock;
+
+int iterationsFor(std::size_t nodes) {
+    return static_cast<int>(std::clamp<std::size_t>(6000 / std::max<std::size_t>(nodes, 1), 3, 50));
+}
+
+enum Method { Constructors, Views, Objects, MethodCount };
+
+struct Timing {
+    double describeUs = 0;
+    double materializeUs = 0;
+    double frameUs = 0;
+};
+
+// Layout and drawing of the whole new screen
+void firstFrame(LVGLApplication& app, Timing& timing) {
+    auto start = Clock::now();
+    app.renderFrame();
+    timing.frameUs += DuiBenchHarness::elapsedUs(start);
+}
+
+bool run(LVGLApplication& app, Method method, std::size_t nodes, const char* file, bool materialize,
+         Timing& timing) {
+    DuiBenchHarness::resetPools();
+    auto start = Clock::now();
+    if (method == Constructors) {
+        auto root = std::make_unique<DuiVStack>(DuiBenchHarness::makeRows(nodes));
+        timing.describeUs += DuiBenchHarness::elapsedUs(start);
+        if (materialize) {
+            start = Clock::now();
+            root->_build(lv_scr_act());
+            timing.materializeUs += DuiBenchHarness::elapsedUs(start);
+            firstFrame(app, timing);
+        }
+        return true;
+    }
+
+    std::unique_ptr<DuiSnapshot> snapshot = DuiSnapshot::load(file);
+    if (!snapshot) {
+        return false;
+    }
+    if (method == Views) {
+        // The views show their labels from the mapping and go before it
+        DuiNodePtr root = snapshot->build();
+        timing.describeUs += DuiBenchHarness::elapsedUs(start);
+        if (materialize && root) {
+            start = Clock::now();
+            root->_build(lv_scr_act());
+            timing.materializeUs += DuiBenchHarness::elapsedUs(start);
+            firstFrame(app, timing);
+        }
+        return root != nullptr;
+    }
+
+    timing.describeUs += DuiBenchHarness::elapsedUs(start);
+    if (materialize) {
+        start = Clock::now();
+        lv_obj_t* obj = snapshot->instantiate(lv_scr_act());
+        timing.materializeUs += DuiBenchHarness::elapsedUs(start);
+        firstFrame(app, timing);
+        lv_obj_delete(obj);
+    }
+    return true;
+}
+
+void bench(LVGLApplication& app, std::size_t nodes, const char* file, bool materialize) {
+    // The snapshot records the description, it does not need to be built
+    std::size_t snapshotNodes = 0, bytes = 0;
+    {
+        auto root = DuiBenchHarness::makeRows(nodes);
+        std::vector<uint8_t> data = DuiSnapshot::serialize(root);
+        if (!DuiSnapshot::save(data, file)) {
+            std::cerr << "cannot write " << file << std::endl;
+            return;
+        }
+        snapshotNodes = DuiSnapshot::fromMemory(data.data(), data.size())->nodeCount();
+        bytes = data.size();
+    }
+
+    int iterations = iterationsFor(nodes);
+    Timing timings[MethodCount];
+    for (int i = 0; i < iterations; ++i) {
+        for (int m = 0; m < MethodCount; ++m) {
+            if (!run(app, static_cast<Method>(m), nodes, file, materialize, timings[m])) {
+                std::cerr << "cannot load " << file << std::endl;
+                return;
+            }
+            // Deleted objects are freed with the next refresh
+            app.renderFrame();
+        }
+    }
+
+    const char* names[] = {"constructors", "views", "objects"};
+    for (int m = 0; m < MethodCount; ++m) {
+        const Timing& t = timings[m];
+        std::printf("%zu,%s,%.1f,", snapshotNodes, names[m], t.describeUs / iterations);
+        if (materialize) {
+            std::printf("%.1f,%.1f,", t.materializeUs / iterations, t.frameUs / iterations);
+        } else {
+            std::printf(",,");
+        }
+        std::printf("%zu\n", m == Constructors ? std::size_t(0) : bytes);
+    }
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> sizes = {30, 300, 3000, 10000};
+    std::size_t materializeLimit = SIZE_MAX;
+    const char* file = "/tmp/dui_snapshot_bench.snap";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            sizes = DuiBenchHarness::parseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--materialize-limit") == 0 && i + 1 < argc) {
+            materializeLimit = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--file") == 0 && i + 1 < argc) {
+            file = argv[++i];
+        }
+    }
+
+    LVGLApplication app;
+    if (!DuiBenchHarness::initHeadless(app)) {
+        return 1;
+    }
+
+    std::printf("nodes,method,describe_us,materialize_us,first_frame_us,snapshot_bytes\n");
+    for (std::size_t nodes : sizes) {
+        bench(app, nodes, file, nodes <= materializeLimit);
+    }
+    std::remove(file);
+    return 0;
+}
@@ -1,35 +1,92 @@
 #include "DuiButton.h"
+#include "core/DuiEventDelegate.h"
+#include "core/DuiMutationQueue.h"
+#include "core/DuiSnapshot.h"
 #include "lvgl.h"
 
-DuiButton::DuiButton(const std::string& label) {
-    m_lvObject = lv_btn_create(lv_scr_act()); // Temporarily create on screen
+DuiButton::DuiButton(std::string_view label) : m_label(label) {
+    m_props.mark(DuiProps::Text);
+}
 
-    lv_obj_t* lbl = lv_label_create(m_lvObject);
-    lv_label_set_text(lbl, label.c_str());
-    lv_obj_center(lbl);
+DuiButton::DuiButton(DuiButton&& other) noexcept
+    : DuiView(std::move(other)), m_label(std::move(other.m_label)), m_onClickAction(std::move(other.m_onClickAction)),
+      m_eventDelegate(other.m_eventDelegate), m_delegateSlot(other.m_delegateSlot) {
+    other.m_eventDelegate = nullptr;
+    if (m_eventDelegate) {
+        m_eventDelegate->rebind(m_delegateSlot, &m_onClickAction);
+    }
+    if (m_lvObject && !m_eventDelegate) {
+        // The click callback carries the view's address, move it to ours
+        lv_obj_remove_event_cb_with_user_data(m_lvObject, lvgl_event_cb, &other);
+        lv_obj_add_event_cb(m_lvObject, lvgl_event_cb, LV_EVENT_CLICKED, this);
+    }
+    if (lv_obj_t* lbl = m_lvObject ? lv_obj_get_child(m_lvObject, 0) : nullptr) {
+        // Short labels live inside the object, the label must follow them
+        m_label.show(lbl);
+    }
+}
 
-    lv_obj_add_event_cb(m_lvObject, lvgl_event_cb, LV_EVENT_CLICKED, this);
+DuiButton::~DuiButton() {
+    if (m_eventDelegate) {
+        m_eventDelegate->remove(m_delegateSlot);
+    }
+    // Inside a subtree being torn down the root's lv_obj_del frees the button
+    // with the rest; only a view removed on its own is parked
+    if (!m_lvObject || m_parent) {
+        return;
+    }
+    // The label must not keep pointing at our buffer
+    lv_label_set_text_static(lv_obj_get_child(m_lvObject, 0), "");
+    if (pool().release(m_lvObject)) {
+        m_lvObject = nullptr;
+    }
 }
 
-DuiButton& DuiButton::setLabel(const std::string& label) {
-    lv_obj_t* lbl = lv_obj_get_child(m_lvObject, 0);
-    if (lbl) {
-        lv_label_set_text(lbl, label.c_str());
+DuiObjectPool& DuiButton::pool() {
+    static DuiObjectPool instance;
+    return instance;
+}
+
+DuiButton& DuiButton::setLabel(std::string_view label) {
+    bool bufferMoved = m_label.assign(label);
+    // The label may still point at the freed buffer; otherwise wait for the frame flush
+    if (bufferMoved && m_lvObject) {
+        m_label.show(lv_obj_get_child(m_lvObject, 0));
     }
+    markDirty(DuiProps::Text);
     return *this;
 }
 
-DuiButton& DuiButton::onClick(std::function<void()> action) & {
+std::string_view DuiButton::label() const {
+    return m_label.view();
+}
+
+DuiButton& DuiButton::staticLabel(const char* label) & {
+    m_label.setStatic(label);
+    markDirty(DuiProps::Text);
+    return *this;
+}
+
+DuiButton&& DuiButton::staticLabel(const char* label) && {
+    return std::move(this->staticLabel(label));
+}
+
+void DuiButton::postLabel(std::string label) {
+    DuiMutationQueue::post(*this, DuiProps::Text, [label = std::move(label)](DuiButton& view) { view.setLabel(label); });
+}
+
+DuiButton& DuiButton::onClick(DuiAction action) & {
     m_onClickAction = std::move(action);
     return *this;
 }
 
-DuiButton&& DuiButton::onClick(std::function<void()> action) && {
+DuiButton&& DuiButton::onClick(DuiAction action) && {
     return std::move(this->onClick(std::move(action)));
 }
 
 DuiButton& DuiButton::bgColor(lv_color_t color) & {
-    lv_obj_set_style_bg_color(m_lvObject, color, LV_PART_MAIN);
+    m_props.bgColor = color;
+    markDirty(DuiProps::BgColor);
     return *this;
 }
 
@@ -37,6 +94,79 @@ DuiButton&& DuiButton::bgColor(lv_color_t color) && {
     return std::move(this->bgColor(color));
 }
 
+void DuiButton::snapshot(DuiSnapshotWriter& writer) const {
+    writer.add(DuiSnapshotType::Button, m_props, m_key, label());
+}
+
+void DuiButton::accountMemory(DuiMemoryWalker& walker) const {
+    walker.add(*this, TypeName, sizeof(DuiButton) + heapBytes(), true);
+}
+
+std::size_t DuiButton::heapBytes() const {
+    return DuiView::heapBytes() + m_label.heapBytes() + m_onClickAction.heapBytes();
+}
+
+lv_obj_t* DuiButton::createObject(lv_obj_t* parent) {
+    // A pooled button comes with its label
+    lv_obj_t* btn = pool().acquire(parent);
+    if (!btn) {
+        btn = lv_btn_create(parent);
+        lv_obj_t* lbl = lv_label_create(btn);
+        lv_obj_center(lbl);
+    }
+
+    // Registered on the final object, so the user data is the view's final address
+    if (!registerWithDelegate(btn)) {
+        lv_obj_add_event_cb(btn, lvgl_event_cb, LV_EVENT_CLICKED, this);
+    }
+    return btn;
+}
+
+bool DuiButton::registerWithDelegate(lv_obj_t* btn) {
+    // Ancestors are materialized before us; once a delegating container is
+    // found the click has to bubble through every object below it
+    DuiViewBase* delegating = m_parent;
+    while (delegating && !delegating->eventDelegate()) {
+        delegating = delegating->parentView();
+    }
+    if (!delegating) {
+        return false;
+    }
+    for (DuiViewBase* ancestor = m_parent; ancestor != delegating; ancestor = ancestor->parentView()) {
+        if (ancestor->lvObject()) {
+            lv_obj_add_flag(ancestor->lvObject(), LV_OBJ_FLAG_EVENT_BUBBLE);
+        }
+    }
+    m_eventDelegate = delegating->eventDelegate();
+    m_delegateSlot = m_eventDelegate->add(btn, &m_onClickAction);
+    return true;
+}
+
+void DuiButton::applyProperties(uint32_t fields) {
+    DuiView::applyProperties(fields);
+    if (fields & DuiProps::Text) {
+        lv_obj_t* lbl = lv_obj_get_child(m_lvObject, 0);
+        if (lbl) {
+            m_label.show(lbl);
+        }
+    }
+    if (fields & DuiProps::BgColor) {
+        lv_obj_set_style_bg_color(m_lvObject, m_props.bgColor, LV_PART_MAIN);
+    }
+}
+
+bool DuiButton::updateFrom(DuiViewBase& next) {
+    bool changed = DuiView::updateFrom(next);
+    auto& other = static_cast<DuiButton&>(next);
+    if (!m_label.sameAs(other.m_label)) {
+        setLabel(other.m_label.view());
+        changed = true;
+    }
+    // Callbacks cannot be compared, the new one always wins; it costs no LVGL work
+    m_onClickAction = std::move(other.m_onClickAction);
+    return changed;
+}
+
 void DuiButton::lvgl_event_cb(lv_event_t* e) {
     DuiButton* self = static_cast<DuiButton*>(lv_event_get_user_data(e));
     if (self && self->m_onClickAction) {
@@ -1,25 +1,68 @@
 #pragma once
 
 #include "core/DuiView.h"
+#include "core/DuiAction.h"
+#include "core/DuiLabelText.h"
+#include "core/DuiObjectPool.h"
+#include "core/DuiTask.h"
+#include <cstdint>
 #include <string>
-#include <functional>
+#include <string_view>
 
 class DuiButton : public DuiView<DuiButton> {
 public:
-    explicit DuiButton(const std::string& label);
-    DuiButton(DuiButton&&) = default; // Use default move constructor
+    static constexpr const char* TypeName = "DuiButton";
 
-    DuiButton& setLabel(const std::string& label);
+    explicit DuiButton(std::string_view label);
+    DuiButton(DuiButton&& other) noexcept;
+    ~DuiButton() override;
+
+    // Buttons (with their label) of destroyed DuiButtons, reused by new ones
+    static DuiObjectPool& pool();
+
+    // Copied into the button's own buffer, which later updates reuse
+    DuiButton& setLabel(std::string_view label);
+    std::string_view label() const;
+
+    // Shown without any copy; the string must outlive the button
+    DuiButton& staticLabel(const char* label) &;
+    DuiButton&& staticLabel(const char* label) &&;
+
+    // Any thread: setLabel() on the UI thread before the next frame, only the
+    // last of several posts between two frames is applied
+    void postLabel(std::string label);
 
     // Modifier for click action
-    DuiButton& onClick(std::function<void()> action) &;
-    DuiButton&& onClick(std::function<void()> action) &&;
+    DuiButton& onClick(DuiAction action) &;
+    DuiButton&& onClick(DuiAction action) &&;
+
+    // co_await button.clicked() inside a DuiTask: resumes at the next click,
+    // false when the button is destroyed first
+    DuiTask::Event clicked() {
+        return DuiTask::event(*this, LV_EVENT_CLICKED);
+    }
 
     // Modifier for background color
     DuiButton& bgColor(lv_color_t color) &;
     DuiButton&& bgColor(lv_color_t color) &&;
 
+    void snapshot(DuiSnapshotWriter& writer) const override;
+    // The label object inside the button counts as part of it
+    void accountMemory(DuiMemoryWalker& walker) const override;
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override;
+    void applyProperties(uint32_t fields) override;
+    bool updateFrom(DuiViewBase& next) override;
+    std::size_t heapBytes() const override;
+
 private:
-    std::function<void()> m_onClickAction;
+    DuiLabelText m_label;
+    DuiAction m_onClickAction;
+    // Set when an ancestor delegates events, the click then reaches us through its table
+    DuiEventDelegate* m_eventDelegate = nullptr;
+    uint32_t m_delegateSlot = 0;
+
+    bool registerWithDelegate(lv_obj_t* btn);
     static void lvgl_event_cb(lv_event_t* e);
 };
@@ -0,0 +1,97 @@
+#include "DuiImage.h"
+#include "core/DuiSnapshot.h"
+#include "lvgl.h"
+
+DuiImage::DuiImage(std::string_view path) : m_path(path) {
+    m_props.mark(DuiProps::Source);
+}
+
+DuiImage::DuiImage(const lv_image_dsc_t* image) : m_image(image) {
+    m_props.mark(DuiProps::Source);
+}
+
+DuiImage::DuiImage(DuiImage&& other) noexcept
+    : DuiView(std::move(other)), m_path(std::move(other.m_path)), m_image(other.m_image), m_cached(other.m_cached),
+      m_decoded(std::move(other.m_decoded)) {}
+
+DuiImage::~DuiImage() {
+    // The object may still point at the decoded pixels, it goes before they can be evicted
+    if (m_lvObject) {
+        lv_obj_delete(m_lvObject);
+        m_lvObject = nullptr;
+    }
+}
+
+DuiImage& DuiImage::setSource(std::string_view path) {
+    m_path.assign(path);
+    m_image = nullptr;
+    markDirty(DuiProps::Source);
+    return *this;
+}
+
+DuiImage& DuiImage::setSource(const lv_image_dsc_t* image) {
+    m_path.clear();
+    m_image = image;
+    markDirty(DuiProps::Source);
+    return *this;
+}
+
+DuiImage& DuiImage::cached(bool enable) & {
+    if (m_cached != enable) {
+        m_cached = enable;
+        markDirty(DuiProps::Source);
+    }
+    return *this;
+}
+
+DuiImage&& DuiImage::cached(bool enable) && {
+    return std::move(this->cached(enable));
+}
+
+const lv_image_dsc_t* DuiImage::decoded() const {
+    return m_decoded.image();
+}
+
+const void* DuiImage::source() const {
+    return m_image ? static_cast<const void*>(m_image) : m_path.c_str();
+}
+
+void DuiImage::snapshot(DuiSnapshotWriter& writer) const {
+    writer.add(DuiSnapshotType::Image, m_props, m_key, m_image ? std::string_view() : std::string_view(m_path));
+}
+
+std::size_t DuiImage::heapBytes() const {
+    return DuiView::heapBytes() + DuiMemory::stringBytes(m_path);
+}
+
+lv_obj_t* DuiImage::createObject(lv_obj_t* parent) {
+    return lv_image_create(parent);
+}
+
+void DuiImage::applyProperties(uint32_t fields) {
+    DuiView::applyProperties(fields);
+    if (fields & DuiProps::Source) {
+        // Acquired before the old copy is released, so showing the same image again never evicts it
+        DuiImageCache::Ref previous = std::move(m_decoded);
+        const void* src = source();
+        if (m_cached) {
+            m_decoded = DuiImageCache::acquire(src);
+        }
+        // Drawable descriptors are shown as they are, sources the cache
+        // cannot hold are left to LVGL's decoders
+        lv_image_set_src(m_lvObject, m_decoded ? static_cast<const void*>(m_decoded.image()) : src);
+    }
+}
+
+bool DuiImage::updateFrom(DuiViewBase& next) {
+    bool changed = DuiView::updateFrom(next);
+    auto& other = static_cast<DuiImage&>(next);
+    if (other.m_image != m_image || other.m_path != m_path || other.m_cached != m_cached) {
+        m_path = std::move(other.m_path);
+        m_image = other.m_image;
+        m_cached = other.m_cached;
+        markDirty(DuiProps::Source);
+        changed = true;
+    }
+    return changed;
+}
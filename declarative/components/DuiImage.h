@@ -0,0 +1,48 @@
+#pragma once
+
+#include "core/DuiView.h"
+#include "core/DuiImageCache.h"
+#include <string>
+#include <string_view>
+
+class DuiImage : public DuiView<DuiImage> {
+public:
+    static constexpr const char* TypeName = "DuiImage";
+
+    // File source, e.g. "A:icons/wifi.png"
+    explicit DuiImage(std::string_view path);
+    // Variable source that outlives the view, e.g. a converted PNG array
+    explicit DuiImage(const lv_image_dsc_t* image);
+    DuiImage(DuiImage&& other) noexcept;
+    ~DuiImage() override;
+
+    DuiImage& setSource(std::string_view path);
+    DuiImage& setSource(const lv_image_dsc_t* image);
+
+    // Draw the decoded copy from DuiImageCache (the default), or hand the
+    // source to LVGL, which decodes it on every draw
+    DuiImage& cached(bool enable) &;
+    DuiImage&& cached(bool enable) &&;
+
+    // Decoded copy being shown, nullptr when not cached, already drawable or
+    // not decodable
+    const lv_image_dsc_t* decoded() const;
+
+    // Only file sources are recorded
+    void snapshot(DuiSnapshotWriter& writer) const override;
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override;
+    void applyProperties(uint32_t fields) override;
+    bool updateFrom(DuiViewBase& next) override;
+    // Decoded pixels belong to DuiImageCache and are reported with it
+    std::size_t heapBytes() const override;
+
+private:
+    const void* source() const;
+
+    std::string m_path;
+    const lv_image_dsc_t* m_image = nullptr;
+    bool m_cached = true;
+    DuiImageCache::Ref m_decoded;
+};
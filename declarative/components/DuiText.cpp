@@ -1,16 +1,174 @@
 #include "DuiText.h"
+#include "core/DuiMutationQueue.h"
+#include "core/DuiSnapshot.h"
 #include "lvgl.h"
 
-DuiText::DuiText(const std::string& text) {
-    m_lvObject = lv_label_create(lv_scr_act()); // Temporarily create on screen
-    lv_label_set_text(m_lvObject, text.c_str());
+DuiText::DuiText(std::string_view text) : m_text(text) {
+    m_props.mark(DuiProps::Text);
 }
 
-DuiText& DuiText::setText(const std::string& text) {
-    lv_label_set_text(m_lvObject, text.c_str());
+DuiText::DuiText(DuiText&& other) noexcept
+    : DuiView(std::move(other)), m_text(std::move(other.m_text)), m_subject(other.m_subject),
+      m_format(std::move(other.m_format)) {
+    other.m_subject = nullptr;
+    if (m_lvObject) {
+        // Short texts live inside the object, the label must follow them
+        m_text.show(m_lvObject);
+    }
+    if (other.m_observer) {
+        lv_observer_remove(other.m_observer);
+        other.m_observer = nullptr;
+        subscribe(m_lvObject);
+    }
+}
+
+DuiText::~DuiText() {
+    if (!m_lvObject) {
+        return;
+    }
+    if (m_observer) {
+        lv_observer_remove(m_observer);
+        m_observer = nullptr;
+    }
+    // Inside a subtree being torn down the root's lv_obj_del frees the label
+    // with the rest; only a view removed on its own is parked
+    if (m_parent) {
+        return;
+    }
+    // The label must not keep pointing at our buffer
+    lv_label_set_text_static(m_lvObject, "");
+    if (pool().release(m_lvObject)) {
+        m_lvObject = nullptr;
+    }
+}
+
+DuiObjectPool& DuiText::pool() {
+    static DuiObjectPool instance;
+    return instance;
+}
+
+DuiText& DuiText::setText(std::string_view text) {
+    textChanged(m_text.assign(text));
+    return *this;
+}
+
+DuiText& DuiText::staticText(const char* text) & {
+    m_text.setStatic(text);
+    textChanged(false);
+    return *this;
+}
+
+DuiText&& DuiText::staticText(const char* text) && {
+    return std::move(this->staticText(text));
+}
+
+DuiText& DuiText::internedText(std::string_view text) & {
+    m_text.setInterned(text);
+    textChanged(false);
+    return *this;
+}
+
+DuiText&& DuiText::internedText(std::string_view text) && {
+    return std::move(this->internedText(text));
+}
+
+void DuiText::textChanged(bool bufferMoved) {
+    // The label may still point at the freed buffer; every other change waits for the frame flush
+    if (bufferMoved && m_lvObject) {
+        m_text.show(m_lvObject);
+    }
+    markDirty(DuiProps::Text);
+}
+
+DuiText& DuiText::text(DuiState<std::string>& state) & {
+    bind(state.subject(), [&state](std::string& out) {
+        out.assign(state.get());
+    });
     return *this;
 }
 
-std::string DuiText::text() const {
-    return lv_label_get_text(m_lvObject);
+DuiText&& DuiText::text(DuiState<std::string>& state) && {
+    return std::move(text(state));
+}
+
+void DuiText::bind(lv_subject_t* subject, std::function<void(std::string&)> format) {
+    if (m_observer) {
+        lv_observer_remove(m_observer);
+        m_observer = nullptr;
+    }
+    m_subject = subject;
+    m_format = std::move(format);
+    if (m_lvObject) {
+        subscribe(m_lvObject);
+    }
+    markDirty(DuiProps::Text);
+}
+
+void DuiText::subscribe(lv_obj_t* obj) {
+    // Tied to the label, LVGL drops the observer when the label is deleted
+    m_observer = lv_subject_add_observer_obj(m_subject, observer_cb, obj, this);
+}
+
+void DuiText::observer_cb(lv_observer_t* observer, lv_subject_t* subject) {
+    (void)subject;
+    // Only mark the text dirty, the label is rendered once at the next frame flush
+    auto* self = static_cast<DuiText*>(lv_observer_get_user_data(observer));
+    self->markDirty(DuiProps::Text);
+}
+
+std::string_view DuiText::text() const {
+    return m_text.view();
+}
+
+void DuiText::postText(std::string text) {
+    DuiMutationQueue::post(*this, DuiProps::Text, [text = std::move(text)](DuiText& view) { view.setText(text); });
+}
+
+void DuiText::snapshot(DuiSnapshotWriter& writer) const {
+    writer.add(DuiSnapshotType::Text, m_props, m_key, text());
+}
+
+std::size_t DuiText::heapBytes() const {
+    return DuiView::heapBytes() + m_text.heapBytes();
+}
+
+lv_obj_t* DuiText::createObject(lv_obj_t* parent) {
+    lv_obj_t* label = pool().acquire(parent);
+    if (!label) {
+        label = lv_label_create(parent);
+    }
+    if (m_subject) {
+        subscribe(label);
+    }
+    return label;
+}
+
+void DuiText::applyProperties(uint32_t fields) {
+    DuiView::applyProperties(fields);
+    if (fields & DuiProps::Text) {
+        if (m_format) {
+            m_format(m_text.buffer());
+        }
+        m_text.show(m_lvObject);
+    }
+}
+
+bool DuiText::updateFrom(DuiViewBase& next) {
+    bool changed = DuiView::updateFrom(next);
+    auto& other = static_cast<DuiText&>(next);
+    if (other.m_subject || m_subject) {
+        // A bound label renders its text from the state, rebinding is enough
+        if (other.m_subject != m_subject) {
+            bind(other.m_subject, std::move(other.m_format));
+            changed = true;
+        } else {
+            m_format = std::move(other.m_format);
+        }
+        return changed;
+    }
+    if (!m_text.sameAs(other.m_text)) {
+        textChanged(m_text.takeFrom(other.m_text));
+        changed = true;
+    }
+    return changed;
 }
@@ -1,13 +1,104 @@
 #pragma once
 
 #include "core/DuiView.h"
+#include "core/DuiState.h"
+#include "core/DuiLabelText.h"
+#include "core/DuiObjectPool.h"
+#include <functional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 class DuiText : public DuiView<DuiText> {
 public:
-    explicit DuiText(const std::string& text);
-    DuiText(DuiText&&) = default;
+    static constexpr const char* TypeName = "DuiText";
 
-    DuiText& setText(const std::string& text);
-    std::string text() const;
+    DuiText() = default;
+    explicit DuiText(std::string_view text);
+    DuiText(DuiText&& other) noexcept;
+    ~DuiText() override;
+
+    // Labels of destroyed DuiTexts, reused by new ones
+    static DuiObjectPool& pool();
+
+    // Copied into the label's own buffer, which later updates reuse
+    DuiText& setText(std::string_view text);
+    std::string_view text() const;
+
+    // Any thread: setText() on the UI thread before the next frame, only the
+    // last of several posts between two frames is applied
+    void postText(std::string text);
+
+    // printf straight into the reused buffer, e.g. format("%d km/h", speed)
+    template<typename... Args>
+    DuiText& format(const char* fmt, Args... args) & {
+        textChanged(m_text.format(fmt, args...));
+        return *this;
+    }
+    template<typename... Args>
+    DuiText&& format(const char* fmt, Args... args) && {
+        return std::move(format(fmt, args...));
+    }
+
+    // Shown without any copy; the string must outlive the label
+    DuiText& staticText(const char* text) &;
+    DuiText&& staticText(const char* text) &&;
+
+    // Shown from one copy in DuiTextPool, shared by every label with the same text
+    DuiText& internedText(std::string_view text) &;
+    DuiText&& internedText(std::string_view text) &&;
+
+    // ==================== Bindings ====================
+    // The label follows the state; changes within one frame become one label update
+    DuiText& text(DuiState<std::string>& state) &;
+    DuiText&& text(DuiState<std::string>& state) &&;
+
+    // Numeric binding rendered through a printf format, e.g. "Count: %d"
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    DuiText& text(DuiState<T>& state, const char* format) & {
+        bind(state.subject(), [&state, format](std::string& out) {
+            DuiLabelText::formatInto(out, format, state.get());
+        });
+        return *this;
+    }
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    DuiText&& text(DuiState<T>& state, const char* format) && {
+        return std::move(text(state, format));
+    }
+
+    // Binding with a custom formatter
+    template<typename T, typename Formatter>
+        requires std::is_invocable_r_v<std::string, Formatter, const T&>
+    DuiText& text(DuiState<T>& state, Formatter formatter) & {
+        bind(state.subject(), [&state, formatter = std::move(formatter)](std::string& out) {
+            out = formatter(state.get());
+        });
+        return *this;
+    }
+    template<typename T, typename Formatter>
+        requires std::is_invocable_r_v<std::string, Formatter, const T&>
+    DuiText&& text(DuiState<T>& state, Formatter formatter) && {
+        return std::move(text(state, std::move(formatter)));
+    }
+
+    void snapshot(DuiSnapshotWriter& writer) const override;
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override;
+    void applyProperties(uint32_t fields) override;
+    bool updateFrom(DuiViewBase& next) override;
+    std::size_t heapBytes() const override;
+
+private:
+    void textChanged(bool bufferMoved);
+    void bind(lv_subject_t* subject, std::function<void(std::string&)> format);
+    void subscribe(lv_obj_t* obj);
+    static void observer_cb(lv_observer_t* observer, lv_subject_t* subject);
+
+    DuiLabelText m_text;
+    lv_subject_t* m_subject = nullptr;
+    lv_observer_t* m_observer = nullptr;
+    std::function<void(std::string&)> m_format; // Renders the bound state into the text buffer
 };
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only void() callable with inline storage
+//
+// Callables up to InlineSize bytes (a lambda capturing three pointers) are
+// stored inside the object, larger ones fall back to the heap. The object is
+// the size of a std::function but keeps more captures inline.
+class DuiAction {
+public:
+    static constexpr std::size_t InlineSize = 3 * sizeof(void*);
+
+    DuiAction() noexcept = default;
+    DuiAction(std::nullptr_t) noexcept {}
+
+    template<typename F>
+        requires (!std::is_same_v<std::remove_cvref_t<F>, DuiAction> && std::is_invocable_v<std::decay_t<F>&>)
+    DuiAction(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            new (m_storage) Fn(std::forward<F>(f));
+            m_ops = &inlineOps<Fn>;
+        } else {
+            *reinterpret_cast<Fn**>(m_storage) = new Fn(std::forward<F>(f));
+            m_ops = &heapOps<Fn>;
+        }
+    }
+
+    DuiAction(DuiAction&& other) noexcept {
+        moveFrom(other);
+    }
+
+    DuiAction& operator=(DuiAction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    DuiAction(const DuiAction&) = delete;
+    DuiAction& operator=(const DuiAction&) = delete;
+
+    ~DuiAction() {
+        reset();
+    }
+
+    void operator()() const {
+        m_ops->invoke(const_cast<unsigned char*>(m_storage));
+    }
+
+    explicit operator bool() const {
+        return m_ops != nullptr;
+    }
+
+    bool isInline() const {
+        return m_ops && m_ops->isInline;
+    }
+
+    // Bytes of a callable that did not fit inline
+    std::size_t heapBytes() const {
+        return m_ops ? m_ops->heapSize : 0;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src);
+        void (*destroy)(void* storage);
+        bool isInline;
+        std::size_t heapSize;
+    };
+
+    template<typename Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= InlineSize && alignof(Fn) <= alignof(void*)
+               && std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template<typename Fn>
+    static constexpr Ops inlineOps = {
+        [](void* s) { (*static_cast<Fn*>(s))(); },
+        [](void* dst, void* src) {
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        },
+        [](void* s) { static_cast<Fn*>(s)->~Fn(); },
+        true,
+        0,
+    };
+
+    template<typename Fn>
+    static constexpr Ops heapOps = {
+        [](void* s) { (**static_cast<Fn**>(s))(); },
+        [](void* dst, void* src) { *static_cast<Fn**>(dst) = *static_cast<Fn**>(src); },
+        [](void* s) { delete *static_cast<Fn**>(s); },
+        false,
+        sizeof(Fn),
+    };
+
+    void moveFrom(DuiAction& other) noexcept {
+        if (other.m_ops) {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+    alignas(void*) unsigned char m_storage[InlineSize];
+    const Ops* m_ops = nullptr;
+};
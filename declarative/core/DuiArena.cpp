@@ -0,0 +1,95 @@
+#include "DuiArena.h"
+#include <cstdint>
+#include <cstdlib>
+
+thread_local DuiArena* DuiArena::s_current = nullptr;
+
+DuiArena::DuiArena(std::size_t chunkSize) : m_chunkSize(chunkSize) {}
+
+DuiArena::~DuiArena() {
+    reset();
+    std::free(m_head);
+}
+
+void* DuiArena::allocate(std::size_t size, std::size_t alignment) {
+    if (m_head) {
+        auto base = reinterpret_cast<std::uintptr_t>(m_head + 1);
+        std::uintptr_t start = (base + m_head->used + alignment - 1) & ~(alignment - 1);
+        if (start + size <= base + m_head->size) {
+            m_bytesUsed += start + size - (base + m_head->used);
+            m_head->used = start + size - base;
+            return reinterpret_cast<void*>(start);
+        }
+    }
+
+    // Oversized requests get a chunk of their own
+    Chunk* chunk = newChunk(size + alignment);
+    auto base = reinterpret_cast<std::uintptr_t>(chunk + 1);
+    std::uintptr_t start = (base + alignment - 1) & ~(alignment - 1);
+    chunk->used = start + size - base;
+    m_bytesUsed += chunk->used;
+    return reinterpret_cast<void*>(start);
+}
+
+DuiArena::Chunk* DuiArena::newChunk(std::size_t minSize) {
+    std::size_t size = minSize > m_chunkSize ? minSize : m_chunkSize;
+    auto* chunk = static_cast<Chunk*>(std::malloc(sizeof(Chunk) + size));
+    if (!chunk) {
+        throw std::bad_alloc();
+    }
+    chunk->next = m_head;
+    chunk->size = size;
+    chunk->used = 0;
+    m_head = chunk;
+    m_bytesReserved += sizeof(Chunk) + size;
+    return chunk;
+}
+
+void DuiArena::reset() {
+    // Roots tear their subtrees down, so children are destroyed in tree order
+    for (auto it = m_finalizers.rbegin(); it != m_finalizers.rend(); ++it) {
+        it->destroy(it->object);
+    }
+    m_finalizers.clear();
+
+    // Keep the oldest chunk around for the next screen
+    while (m_head && m_head->next) {
+        Chunk* next = m_head->next;
+        std::free(m_head);
+        m_head = next;
+    }
+    m_bytesReserved = m_head ? sizeof(Chunk) + m_head->size : 0;
+    if (m_head) {
+        m_head->used = 0;
+    }
+    m_bytesUsed = 0;
+    m_nodeCount = 0;
+}
+
+std::size_t DuiArena::bytesUsed() const {
+    return m_bytesUsed;
+}
+
+std::size_t DuiArena::bytesReserved() const {
+    return m_bytesReserved;
+}
+
+std::size_t DuiArena::nodeCount() const {
+    return m_nodeCount;
+}
+
+DuiArena* DuiArena::current() {
+    return s_current;
+}
+
+DuiArenaScope::DuiArenaScope(DuiArena& arena) : m_previous(DuiArena::s_current) {
+    DuiArena::s_current = &arena;
+}
+
+DuiArenaScope::DuiArenaScope(std::nullptr_t) : m_previous(DuiArena::s_current) {
+    DuiArena::s_current = nullptr;
+}
+
+DuiArenaScope::~DuiArenaScope() {
+    DuiArena::s_current = m_previous;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "DuiViewBase.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump allocator owning all Dui nodes of one screen
+//
+// Nodes get stable addresses, sit next to each other in memory and are freed
+// all at once when the arena is reset or destroyed. Views created while a
+// DuiArenaScope is active are allocated here, otherwise on the heap.
+class DuiArena {
+public:
+    static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+    explicit DuiArena(std::size_t chunkSize = DefaultChunkSize);
+    ~DuiArena();
+
+    DuiArena(const DuiArena&) = delete;
+    DuiArena& operator=(const DuiArena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    // Create a root object; the arena runs its destructor on reset
+    template<typename T, typename... Args>
+    T* make(Args&&... args) {
+        T* obj = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (std::is_base_of_v<DuiViewBase, T>) {
+            obj->m_arenaAllocated = true;
+            ++m_nodeCount;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            m_finalizers.push_back({obj, [](void* p) { static_cast<T*>(p)->~T(); }});
+        }
+        return obj;
+    }
+
+    // Move a view into the current arena (or the heap) as a child node
+    template<typename T>
+    static DuiNodePtr makeNode(T&& view) {
+        using View = std::remove_cvref_t<T>;
+        DuiArena* arena = current();
+        if (!arena) {
+            return DuiNodePtr(new View(std::move(view)));
+        }
+        View* node = new (arena->allocate(sizeof(View), alignof(View))) View(std::move(view));
+        node->m_arenaAllocated = true;
+        ++arena->m_nodeCount;
+        return DuiNodePtr(node);
+    }
+
+    // Destroy the root objects and release all memory but the first chunk
+    void reset();
+
+    std::size_t bytesUsed() const;
+    std::size_t bytesReserved() const;
+    std::size_t nodeCount() const;
+
+    static DuiArena* current();
+
+private:
+    friend class DuiArenaScope;
+
+    struct Chunk {
+        Chunk* next;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    struct Finalizer {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    Chunk* newChunk(std::size_t minSize);
+
+    std::size_t m_chunkSize;
+    Chunk* m_head = nullptr;
+    std::vector<Finalizer> m_finalizers;
+    std::size_t m_bytesUsed = 0;
+    std::size_t m_bytesReserved = 0;
+    std::size_t m_nodeCount = 0;
+
+    static thread_local DuiArena* s_current;
+};
+
+// Routes every view created in its lifetime into the given arena
+class DuiArenaScope {
+public:
+    explicit DuiArenaScope(DuiArena& arena);
+    // Route views to the heap, e.g. for short-lived descriptions
+    explicit DuiArenaScope(std::nullptr_t);
+    ~DuiArenaScope();
+
+    DuiArenaScope(const DuiArenaScope&) = delete;
+    DuiArenaScope& operator=(const DuiArenaScope&) = delete;
+
+private:
+    DuiArena* m_previous;
+};
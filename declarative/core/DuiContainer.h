@@ -0,0 +1,141 @@
+#pragma once
+
+#include "DuiView.h"
+#include "DuiEventDelegate.h"
+#include "DuiArena.h"
+#include "DuiReconciler.h"
+#include "DuiSnapshot.h"
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Collects the children produced by a content builder
+class DuiChildList {
+public:
+    template<typename T>
+        requires std::is_base_of_v<DuiViewBase, std::remove_cvref_t<T>>
+    void operator()(T&& view) {
+        m_nodes.push_back(DuiArena::makeNode(std::move(view)));
+    }
+
+    void operator()(DuiNodePtr node) {
+        m_nodes.push_back(std::move(node));
+    }
+
+    std::vector<DuiNodePtr>& nodes() {
+        return m_nodes;
+    }
+
+private:
+    std::vector<DuiNodePtr> m_nodes;
+};
+
+// Shared child handling for the stack layouts
+template <typename Derived>
+class DuiContainer : public DuiView<Derived> {
+public:
+    DuiContainer() = default;
+
+    DuiContainer(DuiContainer&& other) noexcept
+        : DuiView<Derived>(std::move(other)), m_eventDelegate(std::move(other.m_eventDelegate)),
+          m_children(std::move(other.m_children)) {
+        // Children keep a back pointer, point it at the new home
+        for (const auto& child : m_children) {
+            DuiViewBase::attach(*child, this);
+        }
+    }
+
+    // Handle the clicks of every button below with one handler on this container
+    Derived& delegateEvents() & {
+        if (!m_eventDelegate) {
+            m_eventDelegate = std::make_unique<DuiEventDelegate>();
+        }
+        return static_cast<Derived&>(*this);
+    }
+    Derived&& delegateEvents() && {
+        return std::move(delegateEvents());
+    }
+
+    DuiEventDelegate* eventDelegate() override {
+        return m_eventDelegate.get();
+    }
+
+    void snapshot(DuiSnapshotWriter& writer) const override {
+        uint32_t self = writer.add(Derived::SnapshotType, this->m_props, this->m_key);
+        for (const auto& child : m_children) {
+            writer.addChild(self, *child);
+        }
+    }
+
+    void accountMemory(DuiMemoryWalker& walker) const override {
+        DuiView<Derived>::accountMemory(walker);
+        for (const auto& child : m_children) {
+            walker.addChild(*child);
+        }
+    }
+
+    // Record a child; if the container is already on screen the child is
+    // materialized straight under it
+    void addChild(DuiNodePtr child) {
+        DuiViewBase::attach(*child, this);
+        m_children.push_back(std::move(child));
+        if (this->m_lvObject) {
+            m_children.back()->_build(this->m_lvObject);
+        }
+    }
+
+    // Move a view into the current arena (or the heap) and add it
+    template<typename T>
+        requires std::is_base_of_v<DuiViewBase, std::remove_cvref_t<T>>
+    void addChild(T&& view) {
+        addChild(DuiArena::makeNode(std::move(view)));
+    }
+
+    // Room for count children, for builders that know the count up front
+    void reserveChildren(std::size_t count) {
+        m_children.reserve(count);
+    }
+
+    std::size_t childCount() const {
+        return m_children.size();
+    }
+
+    DuiViewBase* childAt(std::size_t index) const {
+        return m_children[index].get();
+    }
+
+    // Diff a new child description against the live children, see DuiReconciler
+    DuiReconcileStats reconcileChildren(std::vector<DuiNodePtr>& next) {
+        return DuiReconciler::reconcile(*this, m_children, next);
+    }
+
+protected:
+    std::size_t heapBytes() const override {
+        std::size_t bytes = DuiView<Derived>::heapBytes() + m_children.capacity() * sizeof(DuiNodePtr);
+        if (m_eventDelegate) {
+            bytes += sizeof(DuiEventDelegate) + m_eventDelegate->heapBytes();
+        }
+        return bytes;
+    }
+
+    bool updateFrom(DuiViewBase& next) override {
+        bool changed = DuiView<Derived>::updateFrom(next);
+        auto& other = static_cast<DuiContainer&>(next);
+        return reconcileChildren(other.m_children).changed() || changed;
+    }
+
+    void buildChildren() override {
+        // Registered before the children, which add themselves to it
+        if (m_eventDelegate) {
+            m_eventDelegate->attach(this->m_lvObject);
+        }
+        for (const auto& child : m_children) {
+            DuiViewBase::materialize(*child, this->m_lvObject);
+        }
+    }
+
+    // Declared first so the children, which point into it, are destroyed before it
+    std::unique_ptr<DuiEventDelegate> m_eventDelegate;
+    std::vector<DuiNodePtr> m_children;
+};
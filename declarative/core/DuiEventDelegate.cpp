@@ -0,0 +1,51 @@
+#include "DuiEventDelegate.h"
+
+void DuiEventDelegate::attach(lv_obj_t* container) {
+    lv_obj_add_event_cb(container, event_cb, LV_EVENT_CLICKED, this);
+}
+
+uint32_t DuiEventDelegate::add(lv_obj_t* target, const DuiAction* action) {
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_actions[slot] = action;
+    } else {
+        slot = static_cast<uint32_t>(m_actions.size());
+        m_actions.push_back(action);
+    }
+
+    // Slot + 1, so a zero user data means "not delegated"
+    lv_obj_set_user_data(target, reinterpret_cast<void*>(static_cast<uintptr_t>(slot) + 1));
+    lv_obj_add_flag(target, LV_OBJ_FLAG_EVENT_BUBBLE);
+    return slot;
+}
+
+void DuiEventDelegate::rebind(uint32_t slot, const DuiAction* action) {
+    m_actions[slot] = action;
+}
+
+void DuiEventDelegate::remove(uint32_t slot) {
+    m_actions[slot] = nullptr;
+    m_freeSlots.push_back(slot);
+}
+
+std::size_t DuiEventDelegate::size() const {
+    return m_actions.size() - m_freeSlots.size();
+}
+
+void DuiEventDelegate::event_cb(lv_event_t* e) {
+    auto* self = static_cast<DuiEventDelegate*>(lv_event_get_user_data(e));
+    auto slot = reinterpret_cast<uintptr_t>(lv_obj_get_user_data(static_cast<lv_obj_t*>(lv_event_get_target(e))));
+    if (slot == 0 || slot > self->m_actions.size()) {
+        return;
+    }
+    const DuiAction* action = self->m_actions[slot - 1];
+    if (action && *action) {
+        (*action)();
+    }
+}
+
+std::size_t DuiEventDelegate::heapBytes() const {
+    return m_actions.capacity() * sizeof(const DuiAction*) + m_freeSlots.capacity() * sizeof(uint32_t);
+}
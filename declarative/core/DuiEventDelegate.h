@@ -0,0 +1,38 @@
+#pragma once
+
+#include "DuiAction.h"
+#include "lvgl.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One click handler for a whole container
+//
+// Instead of an LVGL event descriptor per button, the delegating container
+// registers a single LV_EVENT_CLICKED handler. Buttons bubble their clicks up
+// to it and are found through a slot index kept in their lv_obj user data.
+class DuiEventDelegate {
+public:
+    DuiEventDelegate() = default;
+    DuiEventDelegate(const DuiEventDelegate&) = delete;
+    DuiEventDelegate& operator=(const DuiEventDelegate&) = delete;
+
+    // Register the handler on the container's object
+    void attach(lv_obj_t* container);
+
+    // Map a target object to an action owned by its view, returns the slot
+    uint32_t add(lv_obj_t* target, const DuiAction* action);
+    // Point a slot at the action's new address after its view moved
+    void rebind(uint32_t slot, const DuiAction* action);
+    void remove(uint32_t slot);
+
+    std::size_t size() const;
+    // Slot table bytes, for DuiMemory
+    std::size_t heapBytes() const;
+
+private:
+    static void event_cb(lv_event_t* e);
+
+    std::vector<const DuiAction*> m_actions;
+    std::vector<uint32_t> m_freeSlots;
+};
@@ -0,0 +1,151 @@
+#include "DuiFlushQueue.h"
+#include "DuiViewBase.h"
+#include <bit>
+
+std::vector<DuiFlushQueue::Queue> DuiFlushQueue::s_queues;
+std::vector<void*> DuiFlushQueue::s_flushed;
+DuiFlushStats DuiFlushQueue::s_stats;
+
+void DuiFlushQueue::refrStartCb(lv_event_t* e) {
+    auto index = reinterpret_cast<uintptr_t>(lv_event_get_user_data(e));
+    flushQueue(s_queues[index]);
+}
+
+// A deleted display drops its pending nodes; a new display at the same
+// address gets a queue and hook of its own
+void DuiFlushQueue::displayDeleteCb(lv_event_t* e) {
+    auto index = reinterpret_cast<uintptr_t>(lv_event_get_user_data(e));
+    Queue& queue = s_queues[index];
+    for (DuiViewBase* view : queue.pending) {
+        if (view) {
+            view->m_flushSlot = -1;
+            view->m_flushQueue = -1;
+        }
+    }
+    queue.pending.clear();
+    queue.display = nullptr;
+}
+
+int32_t DuiFlushQueue::queueFor(lv_display_t* disp) {
+    for (std::size_t i = 0; i < s_queues.size(); ++i) {
+        if (s_queues[i].display == disp) {
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    auto index = s_queues.size();
+    s_queues.push_back({disp, {}});
+    if (disp) {
+        void* userData = reinterpret_cast<void*>(index);
+        lv_display_add_event_cb(disp, refrStartCb, LV_EVENT_REFR_START, userData);
+        lv_display_add_event_cb(disp, displayDeleteCb, LV_EVENT_DELETE, userData);
+    }
+    return static_cast<int32_t>(index);
+}
+
+void DuiFlushQueue::schedule(DuiViewBase& view) {
+    if (view.m_flushSlot >= 0) {
+        return;
+    }
+
+    int32_t queue = queueFor(lv_obj_get_display(view.m_lvObject));
+    std::vector<DuiViewBase*>& pending = s_queues[queue].pending;
+    view.m_flushQueue = static_cast<int16_t>(queue);
+    view.m_flushSlot = static_cast<int32_t>(pending.size());
+    pending.push_back(&view);
+}
+
+void DuiFlushQueue::cancel(DuiViewBase& view) {
+    if (view.m_flushSlot >= 0) {
+        s_queues[view.m_flushQueue].pending[view.m_flushSlot] = nullptr;
+        view.m_flushSlot = -1;
+        view.m_flushQueue = -1;
+    }
+}
+
+void DuiFlushQueue::retarget(DuiViewBase& from, DuiViewBase& to) {
+    to.m_flushSlot = from.m_flushSlot;
+    to.m_flushQueue = from.m_flushQueue;
+    from.m_flushSlot = -1;
+    from.m_flushQueue = -1;
+    if (to.m_flushSlot >= 0) {
+        s_queues[to.m_flushQueue].pending[to.m_flushSlot] = &to;
+    }
+}
+
+void DuiFlushQueue::flush() {
+    for (Queue& queue : s_queues) {
+        flushQueue(queue);
+    }
+}
+
+void DuiFlushQueue::flush(lv_display_t* disp) {
+    for (Queue& queue : s_queues) {
+        if (queue.display == disp) {
+            flushQueue(queue);
+        }
+    }
+}
+
+void DuiFlushQueue::flushQueue(Queue& queue) {
+    if (queue.pending.empty()) {
+        return;
+    }
+
+    // Each node is invalidated once after all of its properties are set,
+    // instead of once per setter
+    lv_display_t* disp = queue.display;
+    bool invalidationEnabled = disp && lv_display_is_invalidation_enabled(disp);
+    if (invalidationEnabled) {
+        lv_display_enable_invalidation(disp, false);
+    }
+
+    uint32_t changed = 0;
+    std::vector<void*>& flushed = s_flushed;
+    flushed.clear();
+    for (DuiViewBase* view : queue.pending) {
+        if (!view) {
+            continue;
+        }
+        view->m_flushSlot = -1;
+        view->m_flushQueue = -1;
+        uint32_t dirty = view->m_props.dirty;
+        if (!dirty || !view->m_lvObject) {
+            continue;
+        }
+        view->m_props.dirty = 0;
+        view->applyProperties(dirty);
+        changed |= dirty;
+        s_stats.propertyWrites += std::popcount(dirty);
+        flushed.push_back(view->m_lvObject);
+    }
+    queue.pending.clear();
+
+    if (invalidationEnabled) {
+        lv_display_enable_invalidation(disp, true);
+    }
+    for (void* obj : flushed) {
+        lv_obj_invalidate(static_cast<lv_obj_t*>(obj));
+    }
+
+    s_stats.invalidations += flushed.size();
+    s_stats.nodesFlushed += flushed.size();
+    if (!flushed.empty()) {
+        ++s_stats.flushes;
+        if (changed & DuiProps::LayoutFields) {
+            ++s_stats.layoutCommits;
+        }
+    }
+}
+
+const DuiFlushStats& DuiFlushQueue::stats() {
+    return s_stats;
+}
+
+void DuiFlushQueue::resetStats() {
+    s_stats = DuiFlushStats{};
+}
+
+void DuiFlushQueue::countModifier() {
+    ++s_stats.modifierCalls;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstdint>
+#include <vector>
+
+class DuiViewBase;
+
+// Counters to compare recorded modifier calls with the LVGL work they cost
+struct DuiFlushStats {
+    uint64_t modifierCalls = 0;  // Modifier calls on built nodes
+    uint64_t propertyWrites = 0; // Properties pushed to LVGL by flushes
+    uint64_t invalidations = 0;  // lv_obj_invalidate calls issued by flushes
+    uint64_t nodesFlushed = 0;
+    uint64_t flushes = 0;        // Non-empty flush passes, at most one per frame
+    uint64_t layoutCommits = 0;  // Flush passes that changed layout properties
+};
+
+// Nodes with pending modifiers, drained once per frame
+//
+// Nodes are queued per display. The queue hooks LV_EVENT_REFR_START of each
+// display it sees, so changes are committed right before that display
+// updates its layout and renders.
+class DuiFlushQueue {
+public:
+    static void schedule(DuiViewBase& view);
+    static void cancel(DuiViewBase& view);
+    static void retarget(DuiViewBase& from, DuiViewBase& to);
+
+    // Push all pending changes now, without waiting for the next frame
+    static void flush();
+    // Push the pending changes of one display
+    static void flush(lv_display_t* disp);
+
+    static const DuiFlushStats& stats();
+    static void resetStats();
+    static void countModifier();
+
+private:
+    struct Queue {
+        lv_display_t* display;
+        std::vector<DuiViewBase*> pending;
+    };
+
+    static int32_t queueFor(lv_display_t* disp);
+    static void flushQueue(Queue& queue);
+    static void refrStartCb(lv_event_t* e);
+    static void displayDeleteCb(lv_event_t* e);
+
+    static std::vector<Queue> s_queues; // One per display, never removed: views keep indices into it
+    static std::vector<void*> s_flushed; // Reused every frame, steady-state flushes do not allocate
+    static DuiFlushStats s_stats;
+};
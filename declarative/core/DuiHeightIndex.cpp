@@ -0,0 +1,77 @@
+#include "DuiHeightIndex.h"
+
+void DuiHeightIndex::reset(std::size_t count, int32_t estimate) {
+    m_estimate = estimate;
+    m_heights.assign(count, estimate);
+    rebuild();
+}
+
+void DuiHeightIndex::resize(std::size_t count) {
+    m_heights.resize(count, m_estimate);
+    rebuild();
+}
+
+std::size_t DuiHeightIndex::size() const {
+    return m_heights.size();
+}
+
+int32_t DuiHeightIndex::heightOf(std::size_t index) const {
+    return m_heights[index];
+}
+
+void DuiHeightIndex::setHeight(std::size_t index, int32_t height) {
+    int64_t delta = static_cast<int64_t>(height) - m_heights[index];
+    if (delta == 0) {
+        return;
+    }
+    m_heights[index] = height;
+    for (std::size_t i = index + 1; i < m_tree.size(); i += i & (~i + 1)) {
+        m_tree[i] += delta;
+    }
+}
+
+int64_t DuiHeightIndex::offsetOf(std::size_t index) const {
+    int64_t sum = 0;
+    for (std::size_t i = index; i > 0; i -= i & (~i + 1)) {
+        sum += m_tree[i];
+    }
+    return sum;
+}
+
+int64_t DuiHeightIndex::totalHeight() const {
+    return offsetOf(m_heights.size());
+}
+
+std::size_t DuiHeightIndex::indexAt(int64_t offset) const {
+    std::size_t count = m_heights.size();
+    if (count == 0) {
+        return 0;
+    }
+
+    std::size_t step = 1;
+    while (step * 2 <= count) {
+        step *= 2;
+    }
+
+    // Largest pos with offsetOf(pos) <= offset
+    std::size_t pos = 0;
+    for (; step > 0; step /= 2) {
+        if (pos + step <= count && m_tree[pos + step] <= offset) {
+            pos += step;
+            offset -= m_tree[pos];
+        }
+    }
+    return pos < count ? pos : count - 1;
+}
+
+void DuiHeightIndex::rebuild() {
+    std::size_t count = m_heights.size();
+    m_tree.assign(count + 1, 0);
+    for (std::size_t i = 1; i <= count; ++i) {
+        m_tree[i] += m_heights[i - 1];
+        std::size_t parent = i + (i & (~i + 1));
+        if (parent <= count) {
+            m_tree[parent] += m_tree[i];
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Row height index for virtualized lists
+//
+// Keeps one height per row, measured or estimated, in a Fenwick tree so the
+// offset of a row and the row at an offset are both O(log n), and a single
+// measurement updates the index in O(log n).
+class DuiHeightIndex {
+public:
+    void reset(std::size_t count, int32_t estimate);
+    // Keep the known heights, new rows get the estimate
+    void resize(std::size_t count);
+
+    std::size_t size() const;
+    int32_t heightOf(std::size_t index) const;
+    void setHeight(std::size_t index, int32_t height);
+
+    // Sum of the heights of all rows before index
+    int64_t offsetOf(std::size_t index) const;
+    int64_t totalHeight() const;
+    // Row covering the given offset, clamped to the last row
+    std::size_t indexAt(int64_t offset) const;
+
+    // Bytes of the height arrays, for DuiMemory
+    std::size_t heapBytes() const {
+        return m_heights.capacity() * sizeof(int32_t) + m_tree.capacity() * sizeof(int64_t);
+    }
+
+private:
+    void rebuild();
+
+    std::vector<int32_t> m_heights;
+    std::vector<int64_t> m_tree; // 1-based Fenwick tree over m_heights
+    int32_t m_estimate = 0;
+};
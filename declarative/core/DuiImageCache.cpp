@@ -0,0 +1,228 @@
+#include "DuiImageCache.h"
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+DuiImageCache::EntryList DuiImageCache::s_entries;
+std::unordered_map<DuiImageCache::Key, DuiImageCache::EntryList::iterator, DuiImageCache::KeyHash>
+    DuiImageCache::s_index;
+std::size_t DuiImageCache::s_budget = 4 * 1024 * 1024;
+DuiImageCacheStats DuiImageCache::s_stats;
+
+DuiImageCache::Ref::Ref(Ref&& other) noexcept : m_entry(std::exchange(other.m_entry, nullptr)) {}
+
+DuiImageCache::Ref& DuiImageCache::Ref::operator=(Ref&& other) noexcept {
+    if (this != &other) {
+        if (m_entry) {
+            release(m_entry);
+        }
+        m_entry = std::exchange(other.m_entry, nullptr);
+    }
+    return *this;
+}
+
+DuiImageCache::Ref::~Ref() {
+    if (m_entry) {
+        release(m_entry);
+    }
+}
+
+const lv_image_dsc_t* DuiImageCache::Ref::image() const {
+    return m_entry ? &m_entry->image : nullptr;
+}
+
+DuiImageCache::Ref DuiImageCache::acquire(const void* src) {
+    if (isDrawable(src)) {
+        ++s_stats.passed;
+        return Ref();
+    }
+    Entry* entry = find(src, true);
+    if (!entry) {
+        return Ref();
+    }
+    ++entry->users;
+    enforceBudget();
+    return Ref(entry);
+}
+
+bool DuiImageCache::preload(const void* src) {
+    if (isDrawable(src)) {
+        return true;
+    }
+    if (!find(src, true)) {
+        return false;
+    }
+    enforceBudget();
+    return true;
+}
+
+bool DuiImageCache::pin(const void* src) {
+    if (isDrawable(src)) {
+        return true;
+    }
+    Entry* entry = find(src, true);
+    if (!entry) {
+        return false;
+    }
+    if (!entry->pinned) {
+        entry->pinned = true;
+        ++s_stats.pinned;
+    }
+    enforceBudget();
+    return true;
+}
+
+void DuiImageCache::unpin(const void* src) {
+    Entry* entry = find(src, false);
+    if (entry && entry->pinned) {
+        entry->pinned = false;
+        --s_stats.pinned;
+        enforceBudget();
+    }
+}
+
+void DuiImageCache::setBudget(std::size_t bytes) {
+    s_budget = bytes;
+    enforceBudget();
+}
+
+std::size_t DuiImageCache::budget() {
+    return s_budget;
+}
+
+void DuiImageCache::trim() {
+    for (auto it = s_entries.begin(); it != s_entries.end();) {
+        if (!it->users && !it->pinned) {
+            evict(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const DuiImageCacheStats& DuiImageCache::stats() {
+    return s_stats;
+}
+
+void DuiImageCache::resetStats() {
+    // The gauges describe the current content and stay
+    DuiImageCacheStats stats;
+    stats.bytes = s_stats.bytes;
+    stats.peakBytes = s_stats.bytes;
+    stats.entries = s_stats.entries;
+    stats.pinned = s_stats.pinned;
+    s_stats = stats;
+}
+
+// Pixels LVGL draws straight from the descriptor; a copy would only double them
+bool DuiImageCache::isDrawable(const void* src) {
+    if (lv_image_src_get_type(src) != LV_IMAGE_SRC_VARIABLE) {
+        return false;
+    }
+    const auto* image = static_cast<const lv_image_dsc_t*>(src);
+    uint32_t cf = image->header.cf;
+    return cf != LV_COLOR_FORMAT_UNKNOWN && cf != LV_COLOR_FORMAT_RAW && cf != LV_COLOR_FORMAT_RAW_ALPHA &&
+           !(image->header.flags & LV_IMAGE_FLAGS_COMPRESSED);
+}
+
+bool DuiImageCache::makeKey(const void* src, Key& key) {
+    switch (lv_image_src_get_type(src)) {
+    case LV_IMAGE_SRC_FILE:
+        key.path = static_cast<const char*>(src);
+        return true;
+    case LV_IMAGE_SRC_VARIABLE:
+        key.variable = src;
+        return true;
+    default:
+        // Symbols are drawn as text, there is nothing to decode
+        return false;
+    }
+}
+
+DuiImageCache::Entry* DuiImageCache::find(const void* src, bool decodeMiss) {
+    Key key;
+    if (!makeKey(src, key)) {
+        return nullptr;
+    }
+    auto found = s_index.find(key);
+    if (found != s_index.end()) {
+        if (decodeMiss) {
+            ++s_stats.hits;
+        }
+        s_entries.splice(s_entries.begin(), s_entries, found->second);
+        return &*found->second;
+    }
+    if (!decodeMiss) {
+        return nullptr;
+    }
+
+    ++s_stats.misses;
+    Entry entry;
+    if (!decode(src, entry)) {
+        ++s_stats.failures;
+        return nullptr;
+    }
+    entry.key = key;
+    s_entries.push_front(std::move(entry));
+    s_index.emplace(std::move(key), s_entries.begin());
+    s_stats.bytes += s_entries.front().bytes;
+    if (s_stats.bytes > s_stats.peakBytes) {
+        s_stats.peakBytes = s_stats.bytes;
+    }
+    ++s_stats.entries;
+    return &s_entries.front();
+}
+
+// Decoders that only stream areas (no whole decoded buffer) are not cached
+bool DuiImageCache::decode(const void* src, Entry& entry) {
+    auto start = std::chrono::steady_clock::now();
+    lv_image_decoder_args_t args{};
+    args.no_cache = true;
+    lv_image_decoder_dsc_t dsc;
+    if (lv_image_decoder_open(&dsc, src, &args) != LV_RESULT_OK) {
+        return false;
+    }
+
+    const lv_draw_buf_t* decoded = dsc.decoded;
+    bool ok = decoded && decoded->data && decoded->data_size;
+    if (ok) {
+        entry.bytes = decoded->data_size;
+        entry.pixels.reset(new uint8_t[entry.bytes]);
+        std::memcpy(entry.pixels.get(), decoded->data, entry.bytes);
+        entry.image.header = decoded->header;
+        // The copy is ours, LVGL must neither free nor draw into it
+        entry.image.header.flags &= ~(LV_IMAGE_FLAGS_ALLOCATED | LV_IMAGE_FLAGS_MODIFIABLE);
+        entry.image.data_size = static_cast<uint32_t>(entry.bytes);
+        entry.image.data = entry.pixels.get();
+    }
+    lv_image_decoder_close(&dsc);
+
+    s_stats.decodeUs += std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start).count();
+    return ok;
+}
+
+void DuiImageCache::release(Entry* entry) {
+    if (--entry->users == 0) {
+        enforceBudget();
+    }
+}
+
+// Free unused entries from the least recently used end until within budget
+void DuiImageCache::enforceBudget() {
+    auto it = s_entries.end();
+    while (s_stats.bytes > s_budget && it != s_entries.begin()) {
+        --it;
+        if (!it->users && !it->pinned) {
+            evict(it++);
+        }
+    }
+}
+
+void DuiImageCache::evict(EntryList::iterator it) {
+    s_stats.bytes -= it->bytes;
+    --s_stats.entries;
+    ++s_stats.evictions;
+    s_index.erase(it->key);
+    s_entries.erase(it);
+}
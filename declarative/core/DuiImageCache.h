@@ -0,0 +1,127 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Counters to size the budget of a screen set
+struct DuiImageCacheStats {
+    uint64_t hits = 0;       // Acquires served from a decoded copy
+    uint64_t misses = 0;     // Acquires that had to decode
+    uint64_t evictions = 0;  // Decoded images freed to stay within the budget
+    uint64_t failures = 0;   // Sources no decoder could open
+    uint64_t passed = 0;     // Acquires of variable images LVGL draws as they are
+    uint64_t decodeUs = 0;   // Time spent decoding misses
+    std::size_t bytes = 0;   // Decoded pixels held now
+    std::size_t peakBytes = 0;
+    std::size_t entries = 0;
+    std::size_t pinned = 0;
+};
+
+// Decoded images shared by every DuiImage, bounded by a byte budget
+//
+// lv_conf.h disables LVGL's own image cache (LV_CACHE_DEF_SIZE 0), so a PNG
+// or JPG source is decoded again every time it is drawn. Images shown through
+// this cache are decoded once; the pixels are copied out of the LVGL heap
+// into the C++ heap and handed to LVGL as a variable image in the decoded
+// color format, which draws without any decoder work.
+//
+// Entries are kept in least recently used order. When the decoded bytes
+// exceed the budget, unused entries are freed from the cold end; entries in
+// use by an image or pinned are never freed, so the budget can be exceeded
+// while they are alive. preload() decodes ahead of time, pin() additionally
+// protects an entry until unpin(), e.g. for the images of a critical screen.
+// UI thread only. Sources are file paths ("A:icons/wifi.png") or
+// const lv_image_dsc_t* that stay valid while cached. A descriptor that is
+// already in a drawable color format (not RAW and not compressed) is passed
+// through: it is neither decoded nor copied, and the Ref stays empty.
+class DuiImageCache {
+    struct Entry;
+
+public:
+    // Use of one decoded image; the pixels stay valid while a Ref holds them
+    class Ref {
+    public:
+        Ref() = default;
+        Ref(Ref&& other) noexcept;
+        Ref& operator=(Ref&& other) noexcept;
+        ~Ref();
+
+        Ref(const Ref&) = delete;
+        Ref& operator=(const Ref&) = delete;
+
+        // Source for lv_image_set_src, nullptr for an empty Ref
+        const lv_image_dsc_t* image() const;
+        explicit operator bool() const {
+            return m_entry != nullptr;
+        }
+
+    private:
+        friend class DuiImageCache;
+        explicit Ref(Entry* entry) : m_entry(entry) {}
+        Entry* m_entry = nullptr;
+    };
+
+    // Decoded copy of src, decoding it on a miss; empty when src is drawn as
+    // it is or cannot be decoded
+    static Ref acquire(const void* src);
+
+    // Decode src now so the first draw does not; false when it cannot be
+    // decoded, true without an entry for sources drawn as they are
+    static bool preload(const void* src);
+    static bool pin(const void* src);
+    static void unpin(const void* src);
+
+    static void setBudget(std::size_t bytes);
+    static std::size_t budget();
+
+    // Free every entry that is neither in use nor pinned
+    static void trim();
+
+    static const DuiImageCacheStats& stats();
+    static void resetStats();
+
+private:
+    struct Key {
+        const void* variable = nullptr; // Variable sources are identified by address
+        std::string path;
+        bool operator==(const Key& other) const {
+            return variable == other.variable && path == other.path;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return key.variable ? std::hash<const void*>()(key.variable) : std::hash<std::string>()(key.path);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        lv_image_dsc_t image{};
+        std::unique_ptr<uint8_t[]> pixels;
+        std::size_t bytes = 0;
+        uint32_t users = 0;
+        bool pinned = false;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static bool isDrawable(const void* src);
+    static bool makeKey(const void* src, Key& key);
+    static Entry* find(const void* src, bool decode);
+    static bool decode(const void* src, Entry& entry);
+    static void release(Entry* entry);
+    static void enforceBudget();
+    static void evict(EntryList::iterator it);
+
+    // Front is the most recently used
+    static EntryList s_entries;
+    static std::unordered_map<Key, EntryList::iterator, KeyHash> s_index;
+    static std::size_t s_budget;
+    static DuiImageCacheStats s_stats;
+};
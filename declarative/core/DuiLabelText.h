@@ -0,0 +1,108 @@
+#pragma once
+
+#include "DuiTextPool.h"
+#include "lvgl.h"
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Text of a label, handed to LVGL without copying it into the LVGL heap
+//
+// The label always shows the text through lv_label_set_text_static. The
+// text is either this object's own buffer, reused (and only ever grown) by
+// every update, or an external string: a caller-owned static string or an
+// entry of DuiTextPool.
+class DuiLabelText {
+public:
+    DuiLabelText() = default;
+    explicit DuiLabelText(std::string_view text) : m_buffer(text) {}
+
+    // The assigning functions return true when the buffer was reallocated;
+    // a label still showing the old buffer must then be re-pointed at once
+    bool assign(std::string_view text) {
+        const char* old = m_buffer.data();
+        m_buffer.assign(text);
+        m_external = nullptr;
+        return m_buffer.data() != old;
+    }
+
+    template<typename... Args>
+    bool format(const char* fmt, Args... args) {
+        const char* old = m_buffer.data();
+        formatInto(m_buffer, fmt, args...);
+        m_external = nullptr;
+        return m_buffer.data() != old;
+    }
+
+    // The string must stay valid for as long as the label shows it
+    void setStatic(const char* text) {
+        m_external = text;
+    }
+
+    void setInterned(std::string_view text) {
+        m_external = DuiTextPool::intern(text);
+    }
+
+    // Storage for bound formatters, switches back to the buffer
+    std::string& buffer() {
+        m_external = nullptr;
+        return m_buffer;
+    }
+
+    const char* c_str() const {
+        return m_external ? m_external : m_buffer.c_str();
+    }
+
+    std::string_view view() const {
+        return m_external ? std::string_view(m_external) : std::string_view(m_buffer);
+    }
+
+    // Bytes of the own buffer beyond its inline storage; external text is not ours
+    std::size_t heapBytes() const {
+        return m_buffer.capacity() > std::string().capacity() ? m_buffer.capacity() + 1 : 0;
+    }
+
+    bool isExternal() const {
+        return m_external != nullptr;
+    }
+
+    // Same mode and same text; external strings compare by address
+    bool sameAs(const DuiLabelText& other) const {
+        if (m_external || other.m_external) {
+            return m_external == other.m_external;
+        }
+        return m_buffer == other.m_buffer;
+    }
+
+    // Take over other's text, keeping this buffer's allocation
+    bool takeFrom(const DuiLabelText& other) {
+        if (other.m_external) {
+            m_external = other.m_external;
+            return false;
+        }
+        return assign(other.m_buffer);
+    }
+
+    void show(lv_obj_t* label) const {
+        lv_label_set_text_static(label, c_str());
+    }
+
+    // printf into out, reusing its capacity; only grows it when the text does not fit
+    template<typename... Args>
+    static void formatInto(std::string& out, const char* fmt, Args... args) {
+        out.resize(out.capacity());
+        int length = std::snprintf(out.data(), out.size() + 1, fmt, args...);
+        if (length < 0) {
+            out.clear();
+        } else if (static_cast<std::size_t>(length) > out.size()) {
+            out.resize(length);
+            std::snprintf(out.data(), out.size() + 1, fmt, args...);
+        } else {
+            out.resize(length);
+        }
+    }
+
+private:
+    std::string m_buffer;
+    const char* m_external = nullptr;
+};
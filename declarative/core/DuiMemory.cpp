@@ -0,0 +1,120 @@
+#include "DuiMemory.h"
+#include "DuiImageCache.h"
+#include "src/lvgl_private.h" /* object, class, style and event list internals */
+#include <cstring>
+#include <ostream>
+
+void DuiMemoryWalker::add(const DuiViewBase& view, const char* type, std::size_t cppBytes, bool ownsLvChildren) {
+    lv_obj_t* obj = view.lvObject();
+    std::size_t lvglBytes = obj ? DuiMemory::lvglObjectBytes(obj, ownsLvChildren) : 0;
+
+    DuiMemoryReport& report = m_report;
+    report.total.nodes += 1;
+    report.total.cppBytes += cppBytes;
+    report.total.lvglBytes += lvglBytes;
+
+    // A screen has a handful of view types
+    DuiMemoryTypeUsage* entry = nullptr;
+    for (DuiMemoryTypeUsage& t : report.types) {
+        if (t.type == type || std::strcmp(t.type, type) == 0) {
+            entry = &t;
+            break;
+        }
+    }
+    if (!entry) {
+        entry = &report.types.emplace_back(DuiMemoryTypeUsage{type, {}});
+    }
+    entry->usage.nodes += 1;
+    entry->usage.cppBytes += cppBytes;
+    entry->usage.lvglBytes += lvglBytes;
+
+    if (m_perNode) {
+        report.nodes.push_back({&view, type, m_depth, cppBytes, lvglBytes});
+    }
+}
+
+void DuiMemoryWalker::addChild(const DuiViewBase& child) {
+    ++m_depth;
+    child.accountMemory(*this);
+    --m_depth;
+}
+
+DuiMemoryReport DuiMemory::measure(const DuiViewBase& root, bool perNode) {
+    DuiMemoryReport report;
+    report.types.reserve(8);
+    DuiMemoryWalker walker(report, perNode);
+    root.accountMemory(walker);
+
+    if (lv_is_initialized()) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        report.lvglHeapSize = mon.total_size;
+        report.lvglHeapUsed = mon.total_size - mon.free_size;
+        report.lvglHeapPeak = mon.max_used;
+        report.lvglFragmentation = mon.frag_pct;
+    }
+    report.imageCacheBytes = DuiImageCache::stats().bytes;
+    return report;
+}
+
+bool DuiMemory::check(const DuiViewBase& root, const DuiMemoryBudget& budget, DuiMemoryReport* report) {
+    DuiMemoryReport measured = measure(root);
+    bool cppOk = !budget.cppBytes || measured.total.cppBytes <= budget.cppBytes;
+    bool lvglOk = !budget.lvglBytes || measured.total.lvglBytes <= budget.lvglBytes;
+    if (!cppOk || !lvglOk) {
+        LV_LOG_WARN("screen over its memory budget: C++ %zu/%zu bytes, LVGL %zu/%zu bytes",
+                    measured.total.cppBytes, budget.cppBytes, measured.total.lvglBytes, budget.lvglBytes);
+    }
+    if (report) {
+        *report = std::move(measured);
+    }
+    return cppOk && lvglOk;
+}
+
+// Mirrors what LVGL allocates for an object (LVGL 9.2): the instance of its
+// class, the style array with local and transition styles, and the special
+// attributes with the children array and event descriptors
+std::size_t DuiMemory::lvglObjectBytes(const lv_obj_t* obj, bool withChildren) {
+    const lv_obj_class_t* cls = obj->class_p;
+    while (cls && !cls->instance_size) {
+        cls = cls->base_class;
+    }
+    std::size_t bytes = cls ? cls->instance_size : 0;
+
+    bytes += obj->style_cnt * sizeof(lv_obj_style_t);
+    for (uint32_t i = 0; i < obj->style_cnt; ++i) {
+        const lv_obj_style_t& style = obj->styles[i];
+        if (style.is_local || style.is_trans) {
+            bytes += sizeof(lv_style_t) + style.style->prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+        }
+    }
+
+    if (const lv_obj_spec_attr_t* attr = obj->spec_attr) {
+        bytes += sizeof(lv_obj_spec_attr_t) + attr->child_cnt * sizeof(lv_obj_t*);
+        const lv_array_t& events = attr->event_list.array;
+        bytes += events.capacity * events.element_size + lv_array_size(&events) * sizeof(lv_event_dsc_t);
+        if (withChildren) {
+            for (uint32_t i = 0; i < attr->child_cnt; ++i) {
+                bytes += lvglObjectBytes(attr->children[i], true);
+            }
+        }
+    }
+    return bytes;
+}
+
+void DuiMemory::print(const DuiMemoryReport& report, std::ostream& out) {
+    out << "Memory: " << report.total.nodes << " views, C++ " << report.total.cppBytes << " bytes, LVGL "
+        << report.total.lvglBytes << " bytes" << std::endl;
+    for (const DuiMemoryTypeUsage& t : report.types) {
+        out << "  " << t.type << ": " << t.usage.nodes << " views, C++ " << t.usage.cppBytes << " bytes, LVGL "
+            << t.usage.lvglBytes << " bytes" << std::endl;
+    }
+    if (report.lvglHeapSize) {
+        out << "  LVGL heap: " << report.lvglHeapUsed << " of " << report.lvglHeapSize << " bytes used, peak "
+            << report.lvglHeapPeak << ", " << report.lvglOtherBytes() << " outside this tree, fragmentation "
+            << static_cast<int>(report.lvglFragmentation) << "%" << std::endl;
+    }
+    if (report.imageCacheBytes) {
+        out << "  Image cache: " << report.imageCacheBytes << " bytes" << std::endl;
+    }
+}
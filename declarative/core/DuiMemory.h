@@ -0,0 +1,102 @@
+#pragma once
+
+#include "DuiViewBase.h"
+#include "lvgl.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct DuiMemoryUsage {
+    std::size_t nodes = 0;
+    std::size_t cppBytes = 0;  // View objects and what they own on the C++ heap (or in their arena)
+    std::size_t lvglBytes = 0; // Objects, styles and event lists in the LVGL heap
+};
+
+// One view of the walked tree, in pre-order
+struct DuiMemoryNode {
+    const DuiViewBase* view;
+    const char* type;
+    uint32_t depth;
+    std::size_t cppBytes;
+    std::size_t lvglBytes;
+};
+
+struct DuiMemoryTypeUsage {
+    const char* type;
+    DuiMemoryUsage usage;
+};
+
+struct DuiMemoryReport {
+    DuiMemoryUsage total;
+    std::vector<DuiMemoryTypeUsage> types;
+    std::vector<DuiMemoryNode> nodes; // Only filled by measure(root, true)
+
+    // The whole LVGL heap from lv_mem_monitor (builtin allocator only, zero otherwise)
+    std::size_t lvglHeapSize = 0;
+    std::size_t lvglHeapUsed = 0;
+    std::size_t lvglHeapPeak = 0;
+    uint8_t lvglFragmentation = 0;
+    // Decoded images held by DuiImageCache, shared by every screen
+    std::size_t imageCacheBytes = 0;
+
+    // LVGL heap in use by anything but the walked tree: display buffers, theme, other screens
+    std::size_t lvglOtherBytes() const {
+        return lvglHeapUsed > total.lvglBytes ? lvglHeapUsed - total.lvglBytes : 0;
+    }
+};
+
+// Limits of one screen, 0 for no limit
+struct DuiMemoryBudget {
+    std::size_t cppBytes = 0;
+    std::size_t lvglBytes = 0;
+};
+
+// Visits the views of a tree for DuiMemory, see DuiViewBase::accountMemory()
+class DuiMemoryWalker {
+public:
+    // Record a view with its C++ bytes; its LVGL object is added here, with
+    // the object's children when they are not views of their own (a button's label)
+    void add(const DuiViewBase& view, const char* type, std::size_t cppBytes, bool ownsLvChildren = false);
+    void addChild(const DuiViewBase& child);
+
+private:
+    friend class DuiMemory;
+    DuiMemoryWalker(DuiMemoryReport& report, bool perNode) : m_report(report), m_perNode(perNode) {}
+
+    DuiMemoryReport& m_report;
+    bool m_perNode;
+    uint32_t m_depth = 0;
+};
+
+// Memory cost of a Dui screen, per node and per view type
+//
+// A screen costs twice: the view objects with the strings, buffers and
+// callables they own on the C++ heap, and the lv_obj_t with its styles,
+// children array and event list in the LVGL builtin heap (LV_MEM_SIZE).
+// measure() walks the tree once and adds both up; the LVGL side is read from
+// the objects' own bookkeeping, so no allocation is tracked and nothing
+// costs anything until a report is asked for. Sizes are payload bytes,
+// without allocator headers. Targets of std::function members (content
+// builders, formatters) are opaque and only count with their inline size.
+// UI thread only.
+class DuiMemory {
+public:
+    // perNode also records every view in report.nodes
+    static DuiMemoryReport measure(const DuiViewBase& root, bool perNode = false);
+
+    // false, with a warning in the LVGL log, when the tree exceeds the budget
+    static bool check(const DuiViewBase& root, const DuiMemoryBudget& budget, DuiMemoryReport* report = nullptr);
+
+    // LVGL heap bytes of one object, optionally with its whole subtree
+    static std::size_t lvglObjectBytes(const lv_obj_t* obj, bool withChildren);
+
+    // Heap bytes of a string beyond its inline buffer
+    static std::size_t stringBytes(const std::string& text) {
+        return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+    }
+
+    // Totals, one line per type and the LVGL heap
+    static void print(const DuiMemoryReport& report, std::ostream& out);
+};
@@ -0,0 +1,251 @@
+#include "DuiMutationQueue.h"
+#include "DuiFlushQueue.h"
+#include "DuiViewBase.h"
+#include <algorithm>
+
+DuiMutationQueue::Node DuiMutationQueue::s_stub;
+std::atomic<DuiMutationQueue::Node*> DuiMutationQueue::s_head{&DuiMutationQueue::s_stub};
+DuiMutationQueue::Node* DuiMutationQueue::s_tail = &DuiMutationQueue::s_stub;
+std::atomic<bool> DuiMutationQueue::s_wakeArmed{true};
+std::atomic<uint64_t> DuiMutationQueue::s_posted{0};
+std::atomic<uint64_t> DuiMutationQueue::s_wakeups{0};
+std::atomic<uint32_t> DuiMutationQueue::s_nextHandle{1};
+DuiMutationQueue::WakeFn DuiMutationQueue::s_wake = nullptr;
+void* DuiMutationQueue::s_wakeContext = nullptr;
+std::vector<DuiMutationQueue::Node*> DuiMutationQueue::s_batch;
+std::unordered_map<DuiMutationQueue::Key, std::size_t, DuiMutationQueue::KeyHash> DuiMutationQueue::s_lastWrite;
+std::vector<uint32_t> DuiMutationQueue::s_retired;
+std::vector<std::pair<uint32_t, DuiViewBase*>> DuiMutationQueue::s_moved;
+DuiViewBase* DuiMutationQueue::s_running = nullptr;
+std::vector<void*> DuiMutationQueue::s_attached;
+DuiMutationStats DuiMutationQueue::s_stats;
+
+namespace {
+
+void refrStartCb(lv_event_t* e) {
+    (void)e;
+    // Posted modifiers are committed by the flush of this same frame
+    if (DuiMutationQueue::drain()) {
+        DuiFlushQueue::flush();
+    }
+}
+
+} // namespace
+
+void DuiMutationQueue::attach(lv_display_t* disp) {
+    if (disp && std::find(s_attached.begin(), s_attached.end(), disp) == s_attached.end()) {
+        lv_display_add_event_cb(disp, refrStartCb, LV_EVENT_REFR_START, nullptr);
+        s_attached.push_back(disp);
+    }
+}
+
+void DuiMutationQueue::setWakeup(WakeFn wake, void* context) {
+    s_wake = wake;
+    s_wakeContext = context;
+}
+
+void DuiMutationQueue::post(DuiAction action) {
+    Node* node = new Node;
+    node->action = std::move(action);
+    push(node);
+}
+
+void DuiMutationQueue::postTo(DuiViewBase& view, uint32_t property, DuiAction action) {
+    Node* node = new Node;
+    node->target = &view;
+    node->handle = handleOf(view);
+    node->property = property;
+    node->action = std::move(action);
+    push(node);
+}
+
+// A view gets its handle from the first post, on whichever thread that runs
+uint32_t DuiMutationQueue::handleOf(DuiViewBase& view) {
+    uint32_t handle = view.m_postHandle.load(std::memory_order_acquire);
+    if (handle) {
+        return handle;
+    }
+    uint32_t fresh = s_nextHandle.fetch_add(1, std::memory_order_relaxed);
+    if (!fresh) {
+        fresh = s_nextHandle.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (view.m_postHandle.compare_exchange_strong(handle, fresh, std::memory_order_acq_rel)) {
+        return fresh;
+    }
+    return handle;
+}
+
+void DuiMutationQueue::link(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = s_head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+void DuiMutationQueue::push(Node* node) {
+    link(node);
+    s_posted.fetch_add(1, std::memory_order_relaxed);
+
+    // Only the first post after a drain wakes the UI thread
+    if (s_wakeArmed.exchange(false, std::memory_order_acq_rel) && s_wake) {
+        s_wakeups.fetch_add(1, std::memory_order_relaxed);
+        s_wake(s_wakeContext);
+    }
+}
+
+// Single consumer; returns nullptr when empty or when a producer is between
+// its exchange and its link, that node is picked up by the next drain
+DuiMutationQueue::Node* DuiMutationQueue::pop() {
+    Node* tail = s_tail;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &s_stub) {
+        if (!next) {
+            return nullptr;
+        }
+        s_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        s_tail = next;
+        return tail;
+    }
+    if (tail != s_head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    link(&s_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        s_tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+// A producer has swapped itself in as the head but not linked its node yet
+bool DuiMutationQueue::linking() {
+    return s_tail != s_head.load(std::memory_order_acquire);
+}
+
+void DuiMutationQueue::collect() {
+    while (Node* node = pop()) {
+        if (node->handle && (!s_retired.empty() || !s_moved.empty())) {
+            if (std::find(s_retired.begin(), s_retired.end(), node->handle) != s_retired.end()) {
+                delete node;
+                ++s_stats.dropped;
+                continue;
+            }
+            for (const auto& [handle, view] : s_moved) {
+                if (handle == node->handle) {
+                    node->target = view;
+                }
+            }
+        }
+        s_batch.push_back(node);
+    }
+    // Every node posted before the last forget() or retarget() is collected now
+    if (!linking()) {
+        s_retired.clear();
+        s_moved.clear();
+    }
+}
+
+std::size_t DuiMutationQueue::drain() {
+    // Re-armed before popping: a post racing with this drain is either
+    // collected here or wakes the loop again
+    s_wakeArmed.store(true, std::memory_order_release);
+    collect();
+    if (s_batch.empty()) {
+        return 0;
+    }
+
+    // Last write per (view, property) wins
+    s_lastWrite.clear();
+    for (std::size_t i = 0; i < s_batch.size(); ++i) {
+        Node* node = s_batch[i];
+        if (node && node->handle && node->property) {
+            s_lastWrite[Key{node->handle, node->property}] = i;
+        }
+    }
+
+    // An action may destroy views, forget() then collects more nodes into
+    // the batch; the running node is taken out first so it is not freed twice
+    std::size_t executed = 0;
+    for (std::size_t i = 0; i < s_batch.size(); ++i) {
+        Node* node = s_batch[i];
+        if (!node) {
+            continue;
+        }
+        s_batch[i] = nullptr;
+        bool superseded = false;
+        if (node->handle && node->property) {
+            auto last = s_lastWrite.find(Key{node->handle, node->property});
+            superseded = last != s_lastWrite.end() && last->second != i;
+        }
+        if (superseded) {
+            ++s_stats.coalesced;
+        } else {
+            s_running = node->target;
+            node->action();
+            s_running = nullptr;
+            ++executed;
+        }
+        delete node;
+    }
+    s_batch.clear();
+
+    s_stats.executed += executed;
+    ++s_stats.drains;
+    return executed;
+}
+
+void DuiMutationQueue::forget(const DuiViewBase& view) {
+    // Never posted to, or nothing posted since the last drain, the common
+    // cases during teardown: the stub is linked back in whenever the list is
+    // emptied
+    uint32_t handle = view.m_postHandle.load(std::memory_order_acquire);
+    if (!handle || (s_batch.empty() && s_head.load(std::memory_order_acquire) == &s_stub)) {
+        return;
+    }
+    collect();
+    for (Node*& node : s_batch) {
+        if (node && node->handle == handle) {
+            delete node;
+            node = nullptr;
+            ++s_stats.dropped;
+        }
+    }
+    // The node of a producer that is still linking shows up at a later collect()
+    if (linking()) {
+        s_retired.push_back(handle);
+    }
+}
+
+void DuiMutationQueue::retarget(DuiViewBase& from, DuiViewBase& to) {
+    uint32_t handle = from.m_postHandle.exchange(0, std::memory_order_acq_rel);
+    to.m_postHandle.store(handle, std::memory_order_release);
+    if (!handle || (s_batch.empty() && s_head.load(std::memory_order_acquire) == &s_stub)) {
+        return;
+    }
+    collect();
+    for (Node* node : s_batch) {
+        if (node && node->handle == handle) {
+            node->target = &to;
+        }
+    }
+    if (linking()) {
+        s_moved.emplace_back(handle, &to);
+    }
+}
+
+DuiMutationStats DuiMutationQueue::stats() {
+    DuiMutationStats stats = s_stats;
+    stats.posted = s_posted.load(std::memory_order_relaxed);
+    stats.wakeups = s_wakeups.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void DuiMutationQueue::resetStats() {
+    s_stats = DuiMutationStats{};
+    s_posted.store(0, std::memory_order_relaxed);
+    s_wakeups.store(0, std::memory_order_relaxed);
+}
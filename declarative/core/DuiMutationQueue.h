@@ -0,0 +1,127 @@
+#pragma once
+
+#include "DuiAction.h"
+#include "lvgl.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DuiViewBase;
+
+// Counters of the cross-thread queue, read on the UI thread
+struct DuiMutationStats {
+    uint64_t posted = 0;    // Commands posted from any thread
+    uint64_t executed = 0;  // Commands run on the UI thread
+    uint64_t coalesced = 0; // Commands dropped because a later write to the same property replaced them
+    uint64_t dropped = 0;   // Commands whose target view was destroyed first
+    uint64_t drains = 0;    // Non-empty drain passes, at most one per frame
+    uint64_t wakeups = 0;   // Wake callbacks issued by posting threads
+};
+
+// Mutations posted by worker threads, applied on the UI thread once per frame
+//
+// The Dui views are not thread-safe, and LVGL itself is not unless it is
+// built with LV_USE_OS, so network and sensor threads post closures here
+// instead of calling setText() or a modifier directly. Posting is lock-free
+// (a Vyukov MPSC list) and never waits for the UI thread. A post allocates
+// its node; a closure larger than DuiAction's inline storage, e.g. one that
+// captures a std::string, allocates once more.
+//
+// attach() hooks LV_EVENT_REFR_START of a display: the queue is drained
+// right before DuiFlushQueue commits modifiers, so posted changes land in
+// the same frame. Commands keyed by (view, property) are coalesced: when a
+// worker writes the same property several times between two frames, only
+// the last write runs. The first post after a drain calls the wake
+// callback once, e.g. LVGLApplication::requestFrame(), so an idle loop
+// renders the change without waiting for its next timer.
+//
+// A command written to a view holds a handle of the view, not its address:
+// it reaches the view wherever it lives when the command runs, follows it
+// when it is moved and is dropped when the view is destroyed first.
+class DuiMutationQueue {
+public:
+    using WakeFn = void (*)(void* context);
+
+    // UI thread, before any worker posts
+    static void attach(lv_display_t* disp);
+    static void setWakeup(WakeFn wake, void* context);
+
+    // Any thread: run action on the UI thread
+    static void post(DuiAction action);
+
+    // Any thread: write one property of a built view, later writes to the same
+    // (view, property) replace earlier ones. property is a DuiProps::Field.
+    // write(view) gets the view on the UI thread and must not capture it.
+    template<typename View, typename F>
+    static void post(View& view, uint32_t property, F&& write) {
+        postTo(view, property, [write = std::forward<F>(write)]() mutable {
+            write(static_cast<View&>(*s_running));
+        });
+    }
+
+    // UI thread: run everything posted so far, returns the commands executed
+    static std::size_t drain();
+
+    // UI thread: drop the commands targeting a view that is being destroyed
+    static void forget(const DuiViewBase& view);
+    // UI thread: the commands targeting from now target to, which takes its place
+    static void retarget(DuiViewBase& from, DuiViewBase& to);
+
+    static DuiMutationStats stats();
+    static void resetStats();
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        DuiViewBase* target = nullptr; // Checked against the handle in collect()
+        uint32_t handle = 0;           // Of the target view, 0 for plain actions
+        uint32_t property = 0;
+        DuiAction action;
+    };
+
+    struct Key {
+        uint32_t handle;
+        uint32_t property;
+        bool operator==(const Key& other) const {
+            return handle == other.handle && property == other.property;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return (static_cast<uint64_t>(key.handle) << 32 | key.property) * 0x9E3779B97F4A7C15ull;
+        }
+    };
+
+    static void postTo(DuiViewBase& view, uint32_t property, DuiAction action);
+    static uint32_t handleOf(DuiViewBase& view);
+    static void link(Node* node);
+    static void push(Node* node);
+    static Node* pop();
+    static void collect();
+    static bool linking();
+
+    static Node s_stub;
+    static std::atomic<Node*> s_head; // Producers append here
+    static Node* s_tail;              // Consumer side
+    static std::atomic<bool> s_wakeArmed;
+    static std::atomic<uint64_t> s_posted;
+    static std::atomic<uint64_t> s_wakeups;
+    static std::atomic<uint32_t> s_nextHandle;
+    static WakeFn s_wake;
+    static void* s_wakeContext;
+
+    // Consumer side, reused every frame
+    static std::vector<Node*> s_batch;
+    static std::unordered_map<Key, std::size_t, KeyHash> s_lastWrite;
+    // Views destroyed or moved while a producer was still linking its node,
+    // applied to the nodes collected after that
+    static std::vector<uint32_t> s_retired;
+    static std::vector<std::pair<uint32_t, DuiViewBase*>> s_moved;
+    static DuiViewBase* s_running; // Target of the command being run
+    static std::vector<void*> s_attached;
+    static DuiMutationStats s_stats;
+};
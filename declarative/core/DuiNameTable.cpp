@@ -0,0 +1,54 @@
+#include "DuiNameTable.h"
+#include <deque>
+#include <unordered_map>
+
+namespace {
+
+struct Table {
+    // A deque never moves its elements, the index points into them
+    std::deque<std::string> names{std::string()};
+    std::unordered_map<std::string_view, uint32_t> ids;
+    std::size_t bytes = 0;
+};
+
+Table& table() {
+    static Table instance;
+    return instance;
+}
+
+} // namespace
+
+uint32_t DuiNameTable::intern(std::string_view name) {
+    if (name.empty()) {
+        return NoName;
+    }
+    Table& t = table();
+    auto it = t.ids.find(name);
+    if (it != t.ids.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(t.names.size());
+    const std::string& stored = t.names.emplace_back(name);
+    t.ids.emplace(stored, id);
+    t.bytes += name.size() + 1;
+    return id;
+}
+
+uint32_t DuiNameTable::find(std::string_view name) {
+    Table& t = table();
+    auto it = t.ids.find(name);
+    return it != t.ids.end() ? it->second : NoName;
+}
+
+const std::string& DuiNameTable::name(uint32_t id) {
+    Table& t = table();
+    return id < t.names.size() ? t.names[id] : t.names.front();
+}
+
+std::size_t DuiNameTable::size() {
+    return table().names.size() - 1;
+}
+
+std::size_t DuiNameTable::bytes() {
+    return table().bytes;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Process-wide symbol table of object names
+//
+// Every distinct name is stored once and identified by a dense 32-bit id,
+// so objects keep the id instead of a string and lookups by id need no
+// hashing. Id 0 is the empty name. Names live until exit; meant for the
+// bounded set of names an application uses. UI thread only.
+class DuiNameTable {
+public:
+    static constexpr uint32_t NoName = 0;
+
+    // Id of name, adding it on first use
+    static uint32_t intern(std::string_view name);
+    // Id of name, or NoName when no object was ever given it
+    static uint32_t find(std::string_view name);
+    // Name of an id returned by intern()
+    static const std::string& name(uint32_t id);
+
+    static std::size_t size();
+    static std::size_t bytes();
+};
@@ -1,9 +1,115 @@
 #include "DuiObject.h"
+#include "DuiNameTable.h"
 
-void DuiObject::setObjectName(const std::string& name) {
-    m_objectName = name;
+namespace {
+
+// Live objects per name id; the id is the index
+std::vector<std::vector<DuiObject*>>& registry() {
+    static std::vector<std::vector<DuiObject*>> instance;
+    return instance;
+}
+
+const std::vector<DuiObject*> noObjects;
+
+} // namespace
+
+DuiObject::DuiObject(std::string_view name) {
+    attach(DuiNameTable::intern(name));
+}
+
+DuiObject::~DuiObject() {
+    detach();
+}
+
+DuiObject::DuiObject(const DuiObject& other) {
+    attach(other.m_nameId);
+}
+
+// The new object takes over the registry slot, no search and no allocation
+DuiObject::DuiObject(DuiObject&& other) noexcept : m_nameId(other.m_nameId), m_nameSlot(other.m_nameSlot) {
+    if (m_nameId) {
+        registry()[m_nameId][m_nameSlot] = this;
+        other.m_nameId = 0;
+    }
+}
+
+DuiObject& DuiObject::operator=(const DuiObject& other) {
+    if (this != &other && m_nameId != other.m_nameId) {
+        detach();
+        attach(other.m_nameId);
+    }
+    return *this;
+}
+
+DuiObject& DuiObject::operator=(DuiObject&& other) noexcept {
+    if (this != &other) {
+        detach();
+        m_nameId = other.m_nameId;
+        m_nameSlot = other.m_nameSlot;
+        if (m_nameId) {
+            registry()[m_nameId][m_nameSlot] = this;
+            other.m_nameId = 0;
+        }
+    }
+    return *this;
+}
+
+void DuiObject::setObjectName(std::string_view name) {
+    uint32_t id = DuiNameTable::intern(name);
+    if (id != m_nameId) {
+        detach();
+        attach(id);
+    }
+}
+
+const std::string& DuiObject::objectName() const {
+    return DuiNameTable::name(m_nameId);
+}
+
+uint32_t DuiObject::objectNameId() const {
+    return m_nameId;
+}
+
+DuiObject* DuiObject::findByName(std::string_view name) {
+    return findByNameId(DuiNameTable::find(name));
+}
+
+DuiObject* DuiObject::findByNameId(uint32_t id) {
+    const std::vector<DuiObject*>& objects = findAllByNameId(id);
+    return objects.empty() ? nullptr : objects.front();
+}
+
+const std::vector<DuiObject*>& DuiObject::findAllByName(std::string_view name) {
+    return findAllByNameId(DuiNameTable::find(name));
+}
+
+const std::vector<DuiObject*>& DuiObject::findAllByNameId(uint32_t id) {
+    std::vector<std::vector<DuiObject*>>& objects = registry();
+    return id && id < objects.size() ? objects[id] : noObjects;
+}
+
+void DuiObject::attach(uint32_t id) {
+    m_nameId = id;
+    if (!id) {
+        return;
+    }
+    std::vector<std::vector<DuiObject*>>& objects = registry();
+    if (id >= objects.size()) {
+        objects.resize(id + 1);
+    }
+    m_nameSlot = static_cast<uint32_t>(objects[id].size());
+    objects[id].push_back(this);
 }
 
-std::string DuiObject::objectName() const {
-    return m_objectName;
+// Swap with the last object of the same name, which takes over the slot
+void DuiObject::detach() {
+    if (!m_nameId) {
+        return;
+    }
+    std::vector<DuiObject*>& objects = registry()[m_nameId];
+    DuiObject* last = objects.back();
+    objects[m_nameSlot] = last;
+    last->m_nameSlot = m_nameSlot;
+    objects.pop_back();
+    m_nameId = 0;
 }
@@ -1,15 +1,46 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
+// Base of every view, with an optional name to find it by
+//
+// The name is interned in DuiNameTable and each object keeps only its id.
+// Named objects are registered per id while they live: construction,
+// copies, moves and destruction keep the registry current, so lookups by
+// name cost one hash and lookups by id none. A moved-from object loses its
+// name. UI thread only.
 class DuiObject {
 public:
     DuiObject() = default;
-    virtual ~DuiObject() = default;
+    explicit DuiObject(std::string_view name);
+    virtual ~DuiObject();
 
-    void setObjectName(const std::string& name);
-    std::string objectName() const;
+    DuiObject(const DuiObject& other);
+    DuiObject(DuiObject&& other) noexcept;
+    DuiObject& operator=(const DuiObject& other);
+    DuiObject& operator=(DuiObject&& other) noexcept;
+
+    // An empty name removes the object from the registry
+    void setObjectName(std::string_view name);
+    const std::string& objectName() const;
+    uint32_t objectNameId() const;
+
+    // One of the live objects with this name, or nullptr; the choice among
+    // objects sharing a name is unspecified
+    static DuiObject* findByName(std::string_view name);
+    static DuiObject* findByNameId(uint32_t id);
+    // Every live object with this name, in no particular order; valid until
+    // the next object with a name is created, renamed or destroyed
+    static const std::vector<DuiObject*>& findAllByName(std::string_view name);
+    static const std::vector<DuiObject*>& findAllByNameId(uint32_t id);
 
 private:
-    std::string m_objectName;
+    void attach(uint32_t id);
+    void detach();
+
+    uint32_t m_nameId = 0;
+    uint32_t m_nameSlot = 0; // Position in the registry entry of m_nameId
 };
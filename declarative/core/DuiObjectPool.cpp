@@ -0,0 +1,84 @@
+#include "DuiObjectPool.h"
+
+DuiObjectPool::DuiObjectPool(std::size_t highWaterMark) : m_highWaterMark(highWaterMark) {}
+
+lv_obj_t* DuiObjectPool::acquire(lv_obj_t* parent) {
+    if (m_parked.empty()) {
+        ++m_stats.misses;
+        return nullptr;
+    }
+    ++m_stats.hits;
+    lv_obj_t* obj = m_parked.back();
+    m_parked.pop_back();
+    lv_obj_set_parent(obj, parent);
+    return obj;
+}
+
+bool DuiObjectPool::release(lv_obj_t* obj) {
+    if (m_parked.size() >= m_highWaterMark) {
+        ++m_stats.dropped;
+        return false;
+    }
+
+    // Back to a freshly created state: theme styles only, no leftover state,
+    // flags or event callbacks. A callback left behind would reach whatever
+    // registered it, e.g. a DuiLazyVStack, from the object's next owner.
+    for (uint32_t i = lv_obj_get_event_count(obj); i > 0; --i) {
+        lv_obj_remove_event(obj, i - 1);
+    }
+    lv_obj_remove_style_all(obj);
+    lv_theme_apply(obj);
+    lv_obj_remove_state(obj, LV_STATE_ANY);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE);
+    lv_obj_set_user_data(obj, nullptr);
+    lv_obj_set_parent(obj, parkingScreen());
+
+    m_parked.push_back(obj);
+    ++m_stats.parked;
+    if (m_parked.size() > m_stats.peak) {
+        m_stats.peak = m_parked.size();
+    }
+    return true;
+}
+
+void DuiObjectPool::setHighWaterMark(std::size_t mark) {
+    m_highWaterMark = mark;
+    while (m_parked.size() > m_highWaterMark) {
+        lv_obj_del(m_parked.back());
+        m_parked.pop_back();
+        ++m_stats.dropped;
+    }
+}
+
+std::size_t DuiObjectPool::highWaterMark() const {
+    return m_highWaterMark;
+}
+
+std::size_t DuiObjectPool::size() const {
+    return m_parked.size();
+}
+
+void DuiObjectPool::clear() {
+    for (lv_obj_t* obj : m_parked) {
+        lv_obj_del(obj);
+    }
+    m_parked.clear();
+}
+
+const DuiPoolStats& DuiObjectPool::stats() const {
+    return m_stats;
+}
+
+void DuiObjectPool::resetStats() {
+    m_stats = DuiPoolStats{};
+}
+
+lv_obj_t* DuiObjectPool::parkingScreen() {
+    // A screen of its own, shared by all pools and never loaded
+    static lv_obj_t* screen = nullptr;
+    if (!screen) {
+        screen = lv_obj_create(nullptr);
+    }
+    return screen;
+}
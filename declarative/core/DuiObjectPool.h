@@ -0,0 +1,54 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Counters to size a pool for a screen
+struct DuiPoolStats {
+    uint64_t hits = 0;     // Objects handed out from the pool
+    uint64_t misses = 0;   // Acquires that found the pool empty
+    uint64_t parked = 0;   // Released objects kept for reuse
+    uint64_t dropped = 0;  // Released objects deleted because the pool was full
+    std::size_t peak = 0;  // Most objects parked at once
+};
+
+// Parked lv_obj_t of one view type, reused instead of deleted and recreated
+//
+// Released objects are reset to their theme styles, lose their event
+// callbacks and are moved under a hidden parking screen that is never
+// loaded, so they are not rendered. Views clear the rest of their state
+// (observers, text) before releasing. Parked objects belong to the parking
+// screen; clear() deletes them.
+class DuiObjectPool {
+public:
+    explicit DuiObjectPool(std::size_t highWaterMark = 32);
+
+    DuiObjectPool(const DuiObjectPool&) = delete;
+    DuiObjectPool& operator=(const DuiObjectPool&) = delete;
+
+    // A parked object moved under parent, or nullptr on a miss
+    lv_obj_t* acquire(lv_obj_t* parent);
+
+    // Park obj; false when the pool is full and the caller must delete it
+    bool release(lv_obj_t* obj);
+
+    // Objects parked beyond the mark are deleted right away
+    void setHighWaterMark(std::size_t mark);
+    std::size_t highWaterMark() const;
+
+    std::size_t size() const;
+    // Delete every parked object
+    void clear();
+
+    const DuiPoolStats& stats() const;
+    void resetStats();
+
+private:
+    static lv_obj_t* parkingScreen();
+
+    std::vector<lv_obj_t*> m_parked;
+    std::size_t m_highWaterMark;
+    DuiPoolStats m_stats;
+};
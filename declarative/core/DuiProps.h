@@ -0,0 +1,51 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstdint>
+
+// Per-node property record
+//
+// Modifiers only write here. The recorded fields are pushed to LVGL in one
+// go when the node is materialized, and pending changes of a live node are
+// pushed once per frame by DuiFlushQueue.
+struct DuiProps {
+    enum Field : uint32_t {
+        Width   = 1u << 0,
+        Height  = 1u << 1,
+        BgColor = 1u << 2,
+        Text    = 1u << 3,
+        Source  = 1u << 4,
+
+        LayoutFields = Width | Height,
+    };
+
+    uint32_t set = 0;   // Fields that carry a value
+    uint32_t dirty = 0; // Fields not yet pushed to LVGL
+
+    int32_t width = 0;
+    int32_t height = 0;
+    lv_color_t bgColor{};
+
+    void mark(uint32_t fields) {
+        set |= fields;
+        dirty |= fields;
+    }
+
+    // Take over the fields recorded in next, return the ones whose value changed
+    uint32_t assign(const DuiProps& next) {
+        uint32_t changed = 0;
+        if ((next.set & Width) && (!(set & Width) || width != next.width)) {
+            width = next.width;
+            changed |= Width;
+        }
+        if ((next.set & Height) && (!(set & Height) || height != next.height)) {
+            height = next.height;
+            changed |= Height;
+        }
+        if ((next.set & BgColor) && (!(set & BgColor) || !lv_color_eq(bgColor, next.bgColor))) {
+            bgColor = next.bgColor;
+            changed |= BgColor;
+        }
+        return changed;
+    }
+};
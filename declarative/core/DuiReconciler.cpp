@@ -0,0 +1,129 @@
+#include "DuiReconciler.h"
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+bool sameType(const DuiViewBase& a, const DuiViewBase& b) {
+    return typeid(a) == typeid(b);
+}
+
+// Mark the longest increasing run of old indices, those nodes never need to move
+std::vector<bool> stableNodes(const std::vector<std::size_t>& origin) {
+    constexpr std::size_t None = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> tails;                  // Position in origin of the tail of each run length
+    std::vector<std::size_t> prev(origin.size(), None);
+    for (std::size_t i = 0; i < origin.size(); ++i) {
+        if (origin[i] == None) {
+            continue;
+        }
+        auto it = std::lower_bound(tails.begin(), tails.end(), origin[i],
+                                   [&](std::size_t t, std::size_t v) { return origin[t] < v; });
+        if (it != tails.begin()) {
+            prev[i] = *(it - 1);
+        }
+        if (it == tails.end()) {
+            tails.push_back(i);
+        } else {
+            *it = i;
+        }
+    }
+
+    std::vector<bool> stable(origin.size(), false);
+    for (std::size_t i = tails.empty() ? None : tails.back(); i != None; i = prev[i]) {
+        stable[i] = true;
+    }
+    return stable;
+}
+
+} // namespace
+
+DuiReconcileStats DuiReconciler::reconcile(DuiViewBase& parent, std::vector<DuiNodePtr>& current,
+                                           std::vector<DuiNodePtr>& next) {
+    DuiReconcileStats stats;
+
+    std::unordered_map<std::string_view, std::size_t> keyed;
+    for (std::size_t i = 0; i < current.size(); ++i) {
+        if (!current[i]->m_key.empty()) {
+            keyed.emplace(current[i]->m_key, i);
+        }
+    }
+
+    constexpr std::size_t New = std::numeric_limits<std::size_t>::max();
+    std::vector<DuiNodePtr> merged;
+    std::vector<std::size_t> origin; // Index in current of each merged node, New for created ones
+    merged.reserve(next.size());
+    origin.reserve(next.size());
+    std::size_t unkeyedCursor = 0;
+
+    for (DuiNodePtr& node : next) {
+        DuiNodePtr* match = nullptr;
+        if (!node->m_key.empty()) {
+            auto it = keyed.find(node->m_key);
+            if (it != keyed.end() && current[it->second] && sameType(*current[it->second], *node)) {
+                match = &current[it->second];
+            }
+        } else {
+            while (unkeyedCursor < current.size()
+                   && (!current[unkeyedCursor] || !current[unkeyedCursor]->m_key.empty())) {
+                ++unkeyedCursor;
+            }
+            if (unkeyedCursor < current.size() && sameType(*current[unkeyedCursor], *node)) {
+                match = &current[unkeyedCursor++];
+            }
+        }
+
+        if (match) {
+            if ((*match)->updateFrom(*node)) {
+                ++stats.updated;
+            } else {
+                ++stats.unchanged;
+            }
+            origin.push_back(static_cast<std::size_t>(match - current.data()));
+            merged.push_back(std::move(*match));
+        } else {
+            node->m_parent = &parent;
+            origin.push_back(New);
+            merged.push_back(std::move(node));
+            ++stats.created;
+        }
+    }
+
+    // Detached leftovers delete their LVGL object like a root would
+    for (DuiNodePtr& old : current) {
+        if (old) {
+            old->m_parent = nullptr;
+            old.reset();
+            ++stats.deleted;
+        }
+    }
+    current = std::move(merged);
+
+    if (!parent.m_lvObject) {
+        return stats;
+    }
+
+    // Survivors outside the longest stable run go to the back, new nodes are
+    // created there; one in-order pass then pulls each of them into place while
+    // the stable ones are already where they belong
+    lv_obj_t* obj = parent.m_lvObject;
+    std::vector<bool> stable = stableNodes(origin);
+    for (std::size_t i = 0; i < current.size(); ++i) {
+        if (origin[i] == New) {
+            current[i]->_build(obj);
+        } else if (!stable[i]) {
+            lv_obj_move_to_index(current[i]->m_lvObject, static_cast<int32_t>(lv_obj_get_child_count(obj)) - 1);
+            ++stats.moved;
+        }
+    }
+    for (std::size_t i = 0; i < current.size(); ++i) {
+        if (!stable[i] && lv_obj_get_child(obj, static_cast<int32_t>(i)) != current[i]->m_lvObject) {
+            lv_obj_move_to_index(current[i]->m_lvObject, static_cast<int32_t>(i));
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "DuiViewBase.h"
+#include <cstddef>
+#include <vector>
+
+// What one reconciliation pass did to the live children
+struct DuiReconcileStats {
+    std::size_t created = 0;
+    std::size_t updated = 0;
+    std::size_t unchanged = 0;
+    std::size_t moved = 0;
+    std::size_t deleted = 0;
+
+    bool changed() const {
+        return created || updated || moved || deleted;
+    }
+};
+
+// Diffs a freshly built child description against the live children
+//
+// Children are matched by key and type; unkeyed children match the next
+// unkeyed live child of the same type. Matched nodes take over the new
+// description and only queue the properties that differ, unmatched new
+// nodes are materialized, leftovers are deleted and survivors are moved
+// only when their index changed.
+class DuiReconciler {
+public:
+    static DuiReconcileStats reconcile(DuiViewBase& parent, std::vector<DuiNodePtr>& current,
+                                       std::vector<DuiNodePtr>& next);
+};
@@ -0,0 +1,485 @@
+#include "DuiSnapshot.h"
+#include "DuiViewBase.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include "components/DuiText.h"
+#include "components/DuiButton.h"
+#include "components/DuiImage.h"
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ==================== Writer ====================
+
+uint32_t DuiSnapshotWriter::add(DuiSnapshotType type, std::string_view key) {
+    DuiSnapshotNode node{};
+    node.type = static_cast<uint8_t>(type);
+    node.parent = m_parent;
+    node.firstProperty = static_cast<uint32_t>(m_properties.size());
+    node.key = key.empty() ? DuiSnapshotNode::NoString : string(key);
+    if (m_parent != DuiSnapshotNode::NoParent) {
+        ++m_nodes[m_parent].childCount;
+    }
+    m_nodes.push_back(node);
+    return static_cast<uint32_t>(m_nodes.size() - 1);
+}
+
+uint32_t DuiSnapshotWriter::add(DuiSnapshotType type, const DuiProps& props, std::string_view key,
+                                std::string_view text) {
+    uint32_t index = add(type, key);
+    if (props.set & DuiProps::Width) {
+        property(DuiSnapshotProperty::Width, static_cast<uint32_t>(props.width));
+    }
+    if (props.set & DuiProps::Height) {
+        property(DuiSnapshotProperty::Height, static_cast<uint32_t>(props.height));
+    }
+    if (props.set & DuiProps::BgColor) {
+        property(DuiSnapshotProperty::BgColor, lv_color_to_u32(props.bgColor));
+    }
+    if (type == DuiSnapshotType::Text || type == DuiSnapshotType::Button) {
+        stringProperty(DuiSnapshotProperty::Text, text);
+    } else if (type == DuiSnapshotType::Image && !text.empty()) {
+        stringProperty(DuiSnapshotProperty::Source, text);
+    }
+    return index;
+}
+
+// Properties follow their node, so each node's records stay contiguous
+void DuiSnapshotWriter::property(DuiSnapshotProperty::Id id, uint32_t value) {
+    DuiSnapshotNode& node = m_nodes.back();
+    if (node.propertyCount == UINT8_MAX) {
+        return;
+    }
+    ++node.propertyCount;
+    m_properties.push_back({id, 0, value});
+}
+
+void DuiSnapshotWriter::stringProperty(DuiSnapshotProperty::Id id, std::string_view text) {
+    property(id, string(text));
+}
+
+void DuiSnapshotWriter::callback(DuiSnapshotProperty::Id id, std::string_view handler) {
+    auto [it, inserted] = m_callbackIndex.try_emplace(std::string(handler), static_cast<uint32_t>(m_callbacks.size()));
+    if (inserted) {
+        m_callbacks.push_back(string(handler));
+    }
+    property(id, it->second);
+}
+
+void DuiSnapshotWriter::addChild(uint32_t parent, const DuiViewBase& child) {
+    uint32_t saved = m_parent;
+    m_parent = parent;
+    child.snapshot(*this);
+    m_parent = saved;
+}
+
+void DuiSnapshotWriter::setParent(uint32_t parent) {
+    m_parent = parent;
+}
+
+std::size_t DuiSnapshotWriter::nodeCount() const {
+    return m_nodes.size();
+}
+
+// Equal strings (repeated labels, keys, handler names) are stored once
+uint32_t DuiSnapshotWriter::string(std::string_view text) {
+    auto [it, inserted] = m_stringIndex.try_emplace(std::string(text), static_cast<uint32_t>(m_strings.size()));
+    if (inserted) {
+        m_strings.append(text);
+        m_strings.push_back('\0');
+    }
+    return it->second;
+}
+
+std::vector<uint8_t> DuiSnapshotWriter::finish() const {
+    DuiSnapshotHeader header{};
+    header.magic = DuiSnapshotHeader::Magic;
+    header.version = DuiSnapshotHeader::CurrentVersion;
+    header.headerSize = sizeof(DuiSnapshotHeader);
+    header.nodeCount = static_cast<uint32_t>(m_nodes.size());
+    header.nodeOffset = sizeof(DuiSnapshotHeader);
+    header.propertyCount = static_cast<uint32_t>(m_properties.size());
+    header.propertyOffset = header.nodeOffset + header.nodeCount * sizeof(DuiSnapshotNode);
+    header.callbackCount = static_cast<uint32_t>(m_callbacks.size());
+    header.callbackOffset = header.propertyOffset + header.propertyCount * sizeof(DuiSnapshotProperty);
+    header.stringOffset = header.callbackOffset + header.callbackCount * sizeof(uint32_t);
+    header.stringSize = static_cast<uint32_t>(m_strings.size());
+
+    std::vector<uint8_t> out(header.stringOffset + header.stringSize);
+    auto copy = [&out](uint32_t offset, const void* data, std::size_t size) {
+        if (size) {
+            std::memcpy(out.data() + offset, data, size);
+        }
+    };
+    copy(0, &header, sizeof(header));
+    copy(header.nodeOffset, m_nodes.data(), m_nodes.size() * sizeof(DuiSnapshotNode));
+    copy(header.propertyOffset, m_properties.data(), m_properties.size() * sizeof(DuiSnapshotProperty));
+    copy(header.callbackOffset, m_callbacks.data(), m_callbacks.size() * sizeof(uint32_t));
+    copy(header.stringOffset, m_strings.data(), m_strings.size());
+    return out;
+}
+
+// ==================== Snapshot ====================
+
+namespace {
+
+// Move a view into the current arena (or the heap), returns it for its modifiers
+template<typename View>
+View& emplace(DuiNodePtr& node, View&& view) {
+    node = DuiArena::makeNode(std::move(view));
+    return static_cast<View&>(*node);
+}
+
+// Key and size, the modifiers every view type has
+template<typename View>
+void applyCommon(View& view, const char* key, const DuiSnapshotProperty* first, uint32_t count) {
+    if (*key) {
+        view.key(key);
+    }
+    for (const DuiSnapshotProperty* p = first; p != first + count; ++p) {
+        if (p->id == DuiSnapshotProperty::Width) {
+            view.width(static_cast<int32_t>(p->value));
+        } else if (p->id == DuiSnapshotProperty::Height) {
+            view.height(static_cast<int32_t>(p->value));
+        }
+    }
+}
+
+bool isContainer(uint8_t type) {
+    return type == static_cast<uint8_t>(DuiSnapshotType::VStack) || type == static_cast<uint8_t>(DuiSnapshotType::HStack);
+}
+
+bool isStringProperty(uint16_t id) {
+    return id == DuiSnapshotProperty::Text || id == DuiSnapshotProperty::Source;
+}
+
+} // namespace
+
+DuiSnapshot::~DuiSnapshot() {
+    if (m_mapped) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+}
+
+std::vector<uint8_t> DuiSnapshot::serialize(const DuiViewBase& root) {
+    DuiSnapshotWriter writer;
+    root.snapshot(writer);
+    return writer.finish();
+}
+
+bool DuiSnapshot::save(const DuiViewBase& root, const char* path) {
+    return save(serialize(root), path);
+}
+
+bool DuiSnapshot::save(const std::vector<uint8_t>& data, const char* path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+std::unique_ptr<DuiSnapshot> DuiSnapshot::load(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // The mapping stays valid without the descriptor
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::unique_ptr<DuiSnapshot> snapshot(new DuiSnapshot());
+    snapshot->m_data = static_cast<const uint8_t*>(data);
+    snapshot->m_size = static_cast<std::size_t>(st.st_size);
+    snapshot->m_mapped = true;
+    if (!snapshot->validate()) {
+        return nullptr;
+    }
+    return snapshot;
+}
+
+std::unique_ptr<DuiSnapshot> DuiSnapshot::fromMemory(const void* data, std::size_t size) {
+    std::unique_ptr<DuiSnapshot> snapshot(new DuiSnapshot());
+    snapshot->m_data = static_cast<const uint8_t*>(data);
+    snapshot->m_size = size;
+    if (!snapshot->validate()) {
+        return nullptr;
+    }
+    return snapshot;
+}
+
+// Checked once at load, so instantiate() and build() can trust every index and offset
+bool DuiSnapshot::validate() {
+    if (m_size < sizeof(DuiSnapshotHeader) || reinterpret_cast<uintptr_t>(m_data) % alignof(uint32_t)) {
+        return false;
+    }
+    m_header = reinterpret_cast<const DuiSnapshotHeader*>(m_data);
+    const DuiSnapshotHeader& h = *m_header;
+    if (h.magic != DuiSnapshotHeader::Magic || h.version != DuiSnapshotHeader::CurrentVersion ||
+        h.headerSize != sizeof(DuiSnapshotHeader) || (h.nodeOffset | h.propertyOffset | h.callbackOffset) % 4) {
+        return false;
+    }
+    uint64_t nodesEnd = uint64_t(h.nodeOffset) + uint64_t(h.nodeCount) * sizeof(DuiSnapshotNode);
+    uint64_t propertiesEnd = uint64_t(h.propertyOffset) + uint64_t(h.propertyCount) * sizeof(DuiSnapshotProperty);
+    uint64_t callbacksEnd = uint64_t(h.callbackOffset) + uint64_t(h.callbackCount) * sizeof(uint32_t);
+    uint64_t stringsEnd = uint64_t(h.stringOffset) + h.stringSize;
+    if (nodesEnd > m_size || propertiesEnd > m_size || callbacksEnd > m_size || stringsEnd > m_size ||
+        (h.stringSize && m_data[stringsEnd - 1] != '\0')) {
+        return false;
+    }
+
+    m_nodes = reinterpret_cast<const DuiSnapshotNode*>(m_data + h.nodeOffset);
+    m_properties = reinterpret_cast<const DuiSnapshotProperty*>(m_data + h.propertyOffset);
+    m_callbacks = reinterpret_cast<const uint32_t*>(m_data + h.callbackOffset);
+    m_strings = reinterpret_cast<const char*>(m_data + h.stringOffset);
+    // build() reserves childCount slots per stack, so the counts must be the real ones
+    std::vector<uint32_t> children(h.nodeCount);
+    for (uint32_t i = 0; i < h.nodeCount; ++i) {
+        const DuiSnapshotNode& node = m_nodes[i];
+        // Only stacks have children, the others would be lost by build()
+        bool parentOk = i == 0 ? node.parent == DuiSnapshotNode::NoParent
+                               : node.parent < i && isContainer(m_nodes[node.parent].type);
+        bool keyOk = node.key == DuiSnapshotNode::NoString || node.key < h.stringSize;
+        bool propertiesOk = uint64_t(node.firstProperty) + node.propertyCount <= h.propertyCount;
+        if (!parentOk || !keyOk || !propertiesOk || node.type > static_cast<uint8_t>(DuiSnapshotType::Image)) {
+            return false;
+        }
+        if (i) {
+            ++children[node.parent];
+        }
+    }
+    for (uint32_t i = 0; i < h.nodeCount; ++i) {
+        if (m_nodes[i].childCount != children[i]) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h.propertyCount; ++i) {
+        const DuiSnapshotProperty& p = m_properties[i];
+        if ((isStringProperty(p.id) && p.value >= h.stringSize) ||
+            (p.id == DuiSnapshotProperty::OnClick && p.value >= h.callbackCount)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h.callbackCount; ++i) {
+        if (m_callbacks[i] >= h.stringSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t DuiSnapshot::nodeCount() const {
+    return m_header->nodeCount;
+}
+
+std::size_t DuiSnapshot::sizeBytes() const {
+    return m_size;
+}
+
+const char* DuiSnapshot::string(uint32_t offset) const {
+    return offset == DuiSnapshotNode::NoString ? "" : m_strings + offset;
+}
+
+const DuiSnapshotProperty* DuiSnapshot::property(const DuiSnapshotNode& node, uint16_t id) const {
+    const DuiSnapshotProperty* first = m_properties + node.firstProperty;
+    for (const DuiSnapshotProperty* p = first; p != first + node.propertyCount; ++p) {
+        if (p->id == id) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+const char* DuiSnapshot::stringProperty(const DuiSnapshotNode& node, uint16_t id) const {
+    const DuiSnapshotProperty* p = property(node, id);
+    return p ? string(p->value) : "";
+}
+
+// ==================== LVGL objects ====================
+
+lv_obj_t* DuiSnapshot::instantiate(lv_obj_t* parent) {
+    uint32_t count = m_header->nodeCount;
+    m_objects.assign(count, nullptr);
+    if (!count) {
+        return nullptr;
+    }
+
+    // One invalidation for the finished tree, like DuiViewBase::_build
+    lv_display_t* disp = parent ? lv_obj_get_display(parent) : lv_display_get_default();
+    bool invalidationEnabled = disp && lv_display_is_invalidation_enabled(disp);
+    if (invalidationEnabled) {
+        lv_display_enable_invalidation(disp, false);
+    }
+
+    // Pre-order: the parent of every node already exists
+    for (uint32_t i = 0; i < count; ++i) {
+        const DuiSnapshotNode& node = m_nodes[i];
+        m_objects[i] = create(node, node.parent == DuiSnapshotNode::NoParent ? parent : m_objects[node.parent]);
+    }
+
+    if (invalidationEnabled) {
+        lv_display_enable_invalidation(disp, true);
+        lv_obj_invalidate(m_objects[0]);
+    }
+    return m_objects[0];
+}
+
+lv_obj_t* DuiSnapshot::create(const DuiSnapshotNode& node, lv_obj_t* parent) {
+    lv_obj_t* obj = nullptr;
+    switch (static_cast<DuiSnapshotType>(node.type)) {
+    case DuiSnapshotType::VStack:
+        obj = DuiVStack::_lvCreateObject(parent);
+        break;
+    case DuiSnapshotType::HStack:
+        obj = DuiHStack::_lvCreateObject(parent);
+        break;
+    case DuiSnapshotType::Text:
+        obj = lv_label_create(parent);
+        lv_label_set_text_static(obj, stringProperty(node, DuiSnapshotProperty::Text));
+        break;
+    case DuiSnapshotType::Button: {
+        obj = lv_btn_create(parent);
+        lv_obj_t* lbl = lv_label_create(obj);
+        lv_obj_center(lbl);
+        lv_label_set_text_static(lbl, stringProperty(node, DuiSnapshotProperty::Text));
+        break;
+    }
+    case DuiSnapshotType::Image: {
+        obj = lv_image_create(parent);
+        const char* path = stringProperty(node, DuiSnapshotProperty::Source);
+        if (*path) {
+            DuiImageCache::Ref image = DuiImageCache::acquire(path);
+            lv_image_set_src(obj, image ? static_cast<const void*>(image.image()) : path);
+            if (image) {
+                m_images.push_back(std::move(image));
+            }
+        }
+        break;
+    }
+    default:
+        obj = lv_obj_create(parent);
+        break;
+    }
+
+    const DuiSnapshotProperty* width = property(node, DuiSnapshotProperty::Width);
+    const DuiSnapshotProperty* height = property(node, DuiSnapshotProperty::Height);
+    if (width && height) {
+        lv_obj_set_size(obj, static_cast<int32_t>(width->value), static_cast<int32_t>(height->value));
+    } else if (width) {
+        lv_obj_set_width(obj, static_cast<int32_t>(width->value));
+    } else if (height) {
+        lv_obj_set_height(obj, static_cast<int32_t>(height->value));
+    }
+    if (const DuiSnapshotProperty* bg = property(node, DuiSnapshotProperty::BgColor)) {
+        lv_obj_set_style_bg_color(obj, lv_color_hex(bg->value & 0xFFFFFF), LV_PART_MAIN);
+    }
+    return obj;
+}
+
+lv_obj_t* DuiSnapshot::find(std::string_view key) const {
+    for (uint32_t i = 0; i < m_objects.size(); ++i) {
+        if (m_nodes[i].key != DuiSnapshotNode::NoString && key == m_strings + m_nodes[i].key) {
+            return m_objects[i];
+        }
+    }
+    return nullptr;
+}
+
+// ==================== Views ====================
+
+DuiNodePtr DuiSnapshot::build(const DuiSnapshotHandlers& handlers) const {
+    uint32_t count = m_header->nodeCount;
+    if (!count) {
+        return nullptr;
+    }
+
+    // Every handler name is looked up once, the nodes refer to it by index
+    std::vector<const DuiSnapshotHandler*> bound(m_header->callbackCount, nullptr);
+    for (uint32_t i = 0; i < bound.size(); ++i) {
+        auto it = handlers.find(string(m_callbacks[i]));
+        if (it != handlers.end()) {
+            bound[i] = &it->second;
+        } else {
+            LV_LOG_WARN("no handler for snapshot callback %s", string(m_callbacks[i]));
+        }
+    }
+
+    // Pre-order: the parent view of every node already exists
+    std::vector<DuiViewBase*> views(count, nullptr);
+    DuiNodePtr root = createView(m_nodes[0], bound);
+    views[0] = root.get();
+    for (uint32_t i = 1; i < count; ++i) {
+        const DuiSnapshotNode& node = m_nodes[i];
+        DuiViewBase* parent = views[node.parent];
+        DuiNodePtr view = parent ? createView(node, bound) : nullptr;
+        if (!view) {
+            continue;
+        }
+        views[i] = view.get();
+        if (m_nodes[node.parent].type == static_cast<uint8_t>(DuiSnapshotType::VStack)) {
+            static_cast<DuiVStack*>(parent)->addChild(std::move(view));
+        } else {
+            static_cast<DuiHStack*>(parent)->addChild(std::move(view));
+        }
+    }
+    return root;
+}
+
+DuiNodePtr DuiSnapshot::createView(const DuiSnapshotNode& node,
+                                   const std::vector<const DuiSnapshotHandler*>& bound) const {
+    const DuiSnapshotProperty* first = m_properties + node.firstProperty;
+    DuiNodePtr view;
+    switch (static_cast<DuiSnapshotType>(node.type)) {
+    case DuiSnapshotType::VStack: {
+        DuiVStack& stack = emplace(view, DuiVStack());
+        stack.reserveChildren(node.childCount);
+        applyCommon(stack, string(node.key), first, node.propertyCount);
+        break;
+    }
+    case DuiSnapshotType::HStack: {
+        DuiHStack& stack = emplace(view, DuiHStack());
+        stack.reserveChildren(node.childCount);
+        applyCommon(stack, string(node.key), first, node.propertyCount);
+        break;
+    }
+    case DuiSnapshotType::Text: {
+        DuiText& text = emplace(view, DuiText());
+        text.staticText(stringProperty(node, DuiSnapshotProperty::Text));
+        applyCommon(text, string(node.key), first, node.propertyCount);
+        break;
+    }
+    case DuiSnapshotType::Button: {
+        DuiButton& button = emplace(view, DuiButton(std::string_view{}));
+        button.staticLabel(stringProperty(node, DuiSnapshotProperty::Text));
+        applyCommon(button, string(node.key), first, node.propertyCount);
+        if (const DuiSnapshotProperty* bg = property(node, DuiSnapshotProperty::BgColor)) {
+            button.bgColor(lv_color_hex(bg->value & 0xFFFFFF));
+        }
+        const DuiSnapshotProperty* click = property(node, DuiSnapshotProperty::OnClick);
+        if (const DuiSnapshotHandler* handler = click ? bound[click->value] : nullptr) {
+            // Nodes keep their address, the button can hand itself to the handler
+            button.onClick([handler, &button] { (*handler)(button); });
+        }
+        break;
+    }
+    case DuiSnapshotType::Image: {
+        DuiImage& image = emplace(view, DuiImage(std::string_view(stringProperty(node, DuiSnapshotProperty::Source))));
+        applyCommon(image, string(node.key), first, node.propertyCount);
+        break;
+    }
+    default:
+        // Views the snapshot could not describe have no view type to recreate
+        return nullptr;
+    }
+    return view;
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "DuiProps.h"
+#include "DuiImageCache.h"
+#include "DuiViewBase.h"
+#include "lvgl.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Object kinds a snapshot can recreate; each maps to the create routine and
+// theme styles of the view type that wrote it
+enum class DuiSnapshotType : uint8_t {
+    Object = 0, // A view the snapshot cannot describe, recreated as a plain lv_obj
+    VStack = 1,
+    HStack = 2,
+    Text = 3,
+    Button = 4,
+    Image = 5,
+};
+
+// On-disk layout, little endian, read in place from the mapping
+//
+//   DuiSnapshotHeader
+//   DuiSnapshotNode[nodeCount]           pre-order: every parent precedes its children
+//   DuiSnapshotProperty[propertyCount]   the properties of each node, contiguous
+//   uint32_t[callbackCount]              handler names (string offsets), see DuiSnapshotHandlers
+//   string table                         null-terminated UTF-8, offsets from its start
+//
+// The version changes with the layout of these records; property ids a
+// reader does not know are skipped, so adding one needs no new version.
+struct DuiSnapshotHeader {
+    static constexpr uint32_t Magic = 0x53495544; // "DUIS"
+    static constexpr uint16_t CurrentVersion = 2;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t nodeCount;
+    uint32_t nodeOffset;
+    uint32_t propertyCount;
+    uint32_t propertyOffset;
+    uint32_t callbackCount;
+    uint32_t callbackOffset;
+    uint32_t stringOffset;
+    uint32_t stringSize;
+};
+
+struct DuiSnapshotNode {
+    static constexpr uint32_t NoParent = 0xFFFFFFFFu;
+    static constexpr uint32_t NoString = 0xFFFFFFFFu;
+
+    uint8_t type;          // DuiSnapshotType
+    uint8_t propertyCount;
+    uint16_t reserved;
+    uint32_t parent;       // Node index, NoParent for the root
+    uint32_t childCount;
+    uint32_t firstProperty;
+    uint32_t key;
+};
+
+struct DuiSnapshotProperty {
+    enum Id : uint16_t {
+        Width = 1,   // int32_t
+        Height = 2,  // int32_t
+        BgColor = 3, // lv_color_to_u32
+        Text = 4,    // String offset: label text
+        Source = 5,  // String offset: image path
+        OnClick = 6, // Callback index
+    };
+
+    uint16_t id;
+    uint16_t reserved;
+    uint32_t value;
+};
+
+static_assert(sizeof(DuiSnapshotHeader) == 40 && sizeof(DuiSnapshotNode) == 20 && sizeof(DuiSnapshotProperty) == 8,
+              "the snapshot layout is part of the file format");
+
+// C++ handlers that the callbacks of a snapshot are bound to by name; the
+// handler gets the view whose event fired
+using DuiSnapshotHandler = std::function<void(DuiViewBase& view)>;
+using DuiSnapshotHandlers = std::unordered_map<std::string, DuiSnapshotHandler>;
+
+// Collects nodes while views record themselves (see DuiViewBase::snapshot())
+// or while a converter walks its own description
+class DuiSnapshotWriter {
+public:
+    // Append a node under the current parent, returns its index
+    uint32_t add(DuiSnapshotType type, std::string_view key = {});
+    // Same, with the recorded fields of props and the text of a label, button or image
+    uint32_t add(DuiSnapshotType type, const DuiProps& props, std::string_view key, std::string_view text = {});
+
+    // Properties of the node added last
+    void property(DuiSnapshotProperty::Id id, uint32_t value);
+    void stringProperty(DuiSnapshotProperty::Id id, std::string_view text);
+    void callback(DuiSnapshotProperty::Id id, std::string_view handler);
+
+    // Record child's subtree under the node at index parent
+    void addChild(uint32_t parent, const DuiViewBase& child);
+    // Parent of the following add() calls, for writers without a view tree
+    void setParent(uint32_t parent);
+
+    std::size_t nodeCount() const;
+    std::vector<uint8_t> finish() const;
+
+private:
+    uint32_t string(std::string_view text);
+
+    std::vector<DuiSnapshotNode> m_nodes;
+    std::vector<DuiSnapshotProperty> m_properties;
+    std::vector<uint32_t> m_callbacks;
+    std::unordered_map<std::string, uint32_t> m_callbackIndex;
+    std::string m_strings;
+    std::unordered_map<std::string, uint32_t> m_stringIndex;
+    uint32_t m_parent = DuiSnapshotNode::NoParent;
+};
+
+// A Dui screen frozen into a compact binary image
+//
+// serialize()/save() record a view tree at build time (structure, sizes,
+// colors, texts, image paths, keys); the dui_layoutc converter writes the
+// same format from a text layout, including callbacks. At runtime load()
+// maps the file and validates every index and offset once. Both ways of
+// creating the screen are a single pass over the node table with nothing
+// left to parse:
+//
+//   instantiate()  plain LVGL objects, the fastest cold start; find() returns
+//                  the object of a keyed node to attach behavior to it
+//   build()        a Dui view tree (DuiVStack, DuiHStack, DuiText, DuiButton,
+//                  DuiImage), with callbacks bound to C++ handlers
+//
+// Labels show their text straight from the mapping, so the DuiSnapshot must
+// outlive the objects and views created from it. Variable image sources and
+// the rows of lazy stacks are not recorded.
+class DuiSnapshot {
+public:
+    ~DuiSnapshot();
+
+    DuiSnapshot(const DuiSnapshot&) = delete;
+    DuiSnapshot& operator=(const DuiSnapshot&) = delete;
+
+    static std::vector<uint8_t> serialize(const DuiViewBase& root);
+    static bool save(const DuiViewBase& root, const char* path);
+    static bool save(const std::vector<uint8_t>& data, const char* path);
+
+    // Map a snapshot file; nullptr when it is missing, not a valid snapshot or of another version
+    static std::unique_ptr<DuiSnapshot> load(const char* path);
+    // Use a snapshot already in memory, e.g. linked into the binary; data must outlive it
+    static std::unique_ptr<DuiSnapshot> fromMemory(const void* data, std::size_t size);
+
+    uint32_t nodeCount() const;
+    std::size_t sizeBytes() const;
+
+    // Create every object under parent, returns the root object
+    lv_obj_t* instantiate(lv_obj_t* parent);
+
+    // Object of the node with this key from the last instantiate(), or nullptr
+    lv_obj_t* find(std::string_view key) const;
+
+    // Create the view tree, not yet built; views go to the current DuiArena.
+    // Callbacks without a handler stay unbound; handlers must outlive the views.
+    DuiNodePtr build(const DuiSnapshotHandlers& handlers = {}) const;
+
+private:
+    DuiSnapshot() = default;
+    bool validate();
+    const char* string(uint32_t offset) const;
+    const DuiSnapshotProperty* property(const DuiSnapshotNode& node, uint16_t id) const;
+    const char* stringProperty(const DuiSnapshotNode& node, uint16_t id) const;
+    lv_obj_t* create(const DuiSnapshotNode& node, lv_obj_t* parent);
+    DuiNodePtr createView(const DuiSnapshotNode& node, const std::vector<const DuiSnapshotHandler*>& bound) const;
+
+    const uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_mapped = false;
+    const DuiSnapshotHeader* m_header = nullptr;
+    const DuiSnapshotNode* m_nodes = nullptr;
+    const DuiSnapshotProperty* m_properties = nullptr;
+    const uint32_t* m_callbacks = nullptr;
+    const char* m_strings = nullptr;
+
+    std::vector<lv_obj_t*> m_objects;
+    std::vector<DuiImageCache::Ref> m_images;
+};
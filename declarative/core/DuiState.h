@@ -0,0 +1,61 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Observable value backed by an lv_subject_t
+//
+// Views bind to the subject with lv_observer, so a change only reaches the
+// views that subscribed to it. int32_t states use an LVGL int subject and can
+// be bound to LVGL widgets directly; other types use a pointer subject that
+// points at the stored value. Bound views must not outlive the state.
+template<typename T>
+class DuiState {
+public:
+    explicit DuiState(T value = T{}) : m_value(std::move(value)) {
+        if constexpr (std::is_same_v<T, int32_t>) {
+            lv_subject_init_int(&m_subject, m_value);
+        } else {
+            lv_subject_init_pointer(&m_subject, &m_value);
+        }
+    }
+
+    ~DuiState() {
+        lv_subject_deinit(&m_subject);
+    }
+
+    // Observers keep the subject's address
+    DuiState(const DuiState&) = delete;
+    DuiState& operator=(const DuiState&) = delete;
+
+    const T& get() const {
+        return m_value;
+    }
+
+    void set(T value) {
+        if (m_value == value) {
+            return;
+        }
+        m_value = std::move(value);
+        if constexpr (std::is_same_v<T, int32_t>) {
+            lv_subject_set_int(&m_subject, m_value);
+        } else {
+            lv_subject_notify(&m_subject);
+        }
+    }
+
+    DuiState& operator=(T value) {
+        set(std::move(value));
+        return *this;
+    }
+
+    lv_subject_t* subject() {
+        return &m_subject;
+    }
+
+private:
+    T m_value;
+    lv_subject_t m_subject;
+};
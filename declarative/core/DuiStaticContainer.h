@@ -0,0 +1,108 @@
+#pragma once
+
+#include "DuiView.h"
+#include "DuiEventDelegate.h"
+#include "DuiSnapshot.h"
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+// Children stored by value in a tuple, for layouts whose content is known at compile time
+//
+// The whole tree lives inside the root object: building it costs no heap
+// allocation per child, and materializing, updating and attaching the
+// children are fold expressions unrolled over the tuple.
+template <typename Derived, typename... Children>
+class DuiStaticContainer : public DuiView<Derived> {
+public:
+    explicit DuiStaticContainer(Children&&... children) : m_children(std::move(children)...) {
+        attachChildren();
+    }
+
+    DuiStaticContainer(DuiStaticContainer&& other) noexcept
+        : DuiView<Derived>(std::move(other)), m_eventDelegate(std::move(other.m_eventDelegate)),
+          m_children(std::move(other.m_children)) {
+        attachChildren();
+    }
+
+    // Handle the clicks of every button below with one handler on this container
+    Derived& delegateEvents() & {
+        if (!m_eventDelegate) {
+            m_eventDelegate = std::make_unique<DuiEventDelegate>();
+        }
+        return static_cast<Derived&>(*this);
+    }
+    Derived&& delegateEvents() && {
+        return std::move(delegateEvents());
+    }
+
+    DuiEventDelegate* eventDelegate() override {
+        return m_eventDelegate.get();
+    }
+
+    void snapshot(DuiSnapshotWriter& writer) const override {
+        uint32_t self = writer.add(Derived::SnapshotType, this->m_props, this->m_key);
+        std::apply([&](const auto&... child) {
+            (writer.addChild(self, child), ...);
+        }, m_children);
+    }
+
+    // The children live inside this object and account for their own part of it
+    void accountMemory(DuiMemoryWalker& walker) const override {
+        walker.add(*this, Derived::TypeName, sizeof(Derived) - sizeof(m_children) + this->heapBytes());
+        std::apply([&](const auto&... child) {
+            (walker.addChild(child), ...);
+        }, m_children);
+    }
+
+    static constexpr std::size_t childCount() {
+        return sizeof...(Children);
+    }
+
+    template<std::size_t I>
+    auto& child() {
+        return std::get<I>(m_children);
+    }
+
+protected:
+    std::size_t heapBytes() const override {
+        std::size_t bytes = DuiView<Derived>::heapBytes();
+        if (m_eventDelegate) {
+            bytes += sizeof(DuiEventDelegate) + m_eventDelegate->heapBytes();
+        }
+        return bytes;
+    }
+
+    void buildChildren() override {
+        // Registered before the children, which add themselves to it
+        if (m_eventDelegate) {
+            m_eventDelegate->attach(this->m_lvObject);
+        }
+        std::apply([this](auto&... child) {
+            (DuiViewBase::materialize(child, this->m_lvObject), ...);
+        }, m_children);
+    }
+
+    // Same type means same shape, children are paired up by position
+    bool updateFrom(DuiViewBase& next) override {
+        bool changed = DuiView<Derived>::updateFrom(next);
+        auto& other = static_cast<DuiStaticContainer&>(next);
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((changed = DuiViewBase::updateChild(std::get<I>(m_children), std::get<I>(other.m_children)) || changed),
+             ...);
+        }(std::index_sequence_for<Children...>{});
+        return changed;
+    }
+
+private:
+    void attachChildren() {
+        std::apply([this](auto&... child) {
+            (DuiViewBase::attach(child, this), ...);
+        }, m_children);
+    }
+
+    // Declared first so the children, which point into it, are destroyed before it
+    std::unique_ptr<DuiEventDelegate> m_eventDelegate;
+    std::tuple<Children...> m_children;
+};
@@ -0,0 +1,482 @@
+#include "DuiTask.h"
+#include "DuiViewBase.h"
+#include <algorithm>
+#include <new>
+#include <utility>
+
+lv_timer_t* DuiTask::s_timer = nullptr;
+std::vector<DuiTask::Waiter*> DuiTask::s_ready;
+std::vector<DuiTask::Waiter*> DuiTask::s_sleeping;
+std::vector<DuiTask::Event*> DuiTask::s_listening;
+DuiTask::promise_type* DuiTask::s_spawned = nullptr;
+std::size_t DuiTask::s_cancelPending = 0;
+DuiTaskStats DuiTask::s_stats;
+
+namespace {
+
+// Frames are pooled in 64-byte classes up to 1 KiB, larger ones use the heap
+constexpr std::size_t FrameGranule = 64;
+constexpr std::size_t PooledClasses = 16;
+constexpr std::size_t PoolBudget = 64 * 1024;
+
+struct FreeFrame {
+    FreeFrame* next;
+};
+
+FreeFrame* freeFrames[PooledClasses + 1] = {};
+
+bool isBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+}
+
+} // namespace
+
+// ==================== Task ====================
+
+DuiTask::DuiTask(DuiTask&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+DuiTask& DuiTask::operator=(DuiTask&& other) noexcept {
+    if (this != &other) {
+        cancel();
+        m_handle = std::exchange(other.m_handle, {});
+    }
+    return *this;
+}
+
+DuiTask::~DuiTask() {
+    cancel();
+}
+
+void DuiTask::start() {
+    if (m_handle && !m_handle.promise().started) {
+        m_handle.promise().started = true;
+        ++s_stats.started;
+        m_handle.resume();
+    }
+}
+
+void DuiTask::cancel() {
+    if (!m_handle) {
+        return;
+    }
+    if (!m_handle.done()) {
+        ++s_stats.cancelled;
+    }
+    std::exchange(m_handle, {}).destroy();
+}
+
+bool DuiTask::done() const {
+    return !m_handle || m_handle.done();
+}
+
+void DuiTask::spawn(DuiViewBase& owner, DuiTask task) {
+    adopt(task, &owner);
+}
+
+void DuiTask::spawn(DuiTask task) {
+    adopt(task, nullptr);
+}
+
+void DuiTask::adopt(DuiTask& task, const DuiViewBase* owner) {
+    Handle handle = std::exchange(task.m_handle, {});
+    if (!handle) {
+        return;
+    }
+    if (handle.done()) {
+        handle.destroy();
+        return;
+    }
+    promise_type& promise = handle.promise();
+    promise.owner = owner;
+    promise.spawned = true;
+    link(promise);
+    if (!promise.started) {
+        promise.started = true;
+        ++s_stats.started;
+        handle.resume(); // May finish and free itself right here
+    }
+}
+
+void DuiTask::link(promise_type& promise) {
+    promise.prev = nullptr;
+    promise.next = s_spawned;
+    if (s_spawned) {
+        s_spawned->prev = &promise;
+    }
+    s_spawned = &promise;
+}
+
+void DuiTask::unlink(promise_type& promise) {
+    if (promise.prev) {
+        promise.prev->next = promise.next;
+    } else {
+        s_spawned = promise.next;
+    }
+    if (promise.next) {
+        promise.next->prev = promise.prev;
+    }
+    promise.prev = promise.next = nullptr;
+    if (promise.cancelPending) {
+        promise.cancelPending = false;
+        --s_cancelPending;
+    }
+}
+
+std::coroutine_handle<> DuiTask::FinalAwaiter::await_suspend(Handle handle) noexcept {
+    promise_type& promise = handle.promise();
+    ++s_stats.completed;
+    if (promise.continuation) {
+        return promise.continuation;
+    }
+    if (promise.exception) {
+        LV_LOG_WARN("DuiTask: a task ended with an unhandled exception");
+    }
+    if (promise.spawned) {
+        unlink(promise);
+        handle.destroy();
+    }
+    return std::noop_coroutine();
+}
+
+DuiTask::Awaiter DuiTask::operator co_await() && noexcept {
+    return Awaiter(m_handle);
+}
+
+std::coroutine_handle<> DuiTask::Awaiter::await_suspend(std::coroutine_handle<> caller) noexcept {
+    promise_type& promise = m_handle.promise();
+    promise.continuation = caller;
+    if (promise.started) {
+        return std::noop_coroutine();
+    }
+    promise.started = true;
+    ++s_stats.started;
+    return m_handle;
+}
+
+void DuiTask::Awaiter::await_resume() const {
+    if (m_handle && m_handle.promise().exception) {
+        std::rethrow_exception(m_handle.promise().exception);
+    }
+}
+
+void DuiTask::forget(const DuiViewBase& view) {
+    if ((s_listening.empty() && !s_spawned) || !lv_is_initialized()) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < s_listening.size();) {
+        Event* event = s_listening[i];
+        if (event->m_view == &view) {
+            event->stopListening(); // Removes it from s_listening
+            makeReady(*event);
+        } else {
+            ++i;
+        }
+    }
+
+    // The owner may be destroyed from inside one of its own tasks, so the
+    // frames are destroyed by the next timer pass, before anything resumes
+    bool cancelled = false;
+    for (promise_type* promise = s_spawned; promise; promise = promise->next) {
+        if (promise->owner == &view && !promise->cancelPending) {
+            promise->owner = nullptr;
+            promise->cancelPending = true;
+            ++s_cancelPending;
+            cancelled = true;
+        }
+    }
+    if (cancelled) {
+        ensureTimer();
+        reschedule();
+    }
+}
+
+void DuiTask::retarget(const DuiViewBase& from, const DuiViewBase& to) {
+    if (s_listening.empty() && !s_spawned) {
+        return;
+    }
+    // The LVGL object moves with the view, the event callbacks stay
+    for (Event* event : s_listening) {
+        if (event->m_view == &from) {
+            event->m_view = &to;
+        }
+    }
+    for (promise_type* promise = s_spawned; promise; promise = promise->next) {
+        if (promise->owner == &from) {
+            promise->owner = &to;
+        }
+    }
+}
+
+void DuiTask::destroyCancelled() {
+    while (s_cancelPending) {
+        promise_type* promise = s_spawned;
+        while (promise && !promise->cancelPending) {
+            promise = promise->next;
+        }
+        if (!promise) {
+            s_cancelPending = 0;
+            return;
+        }
+        // Destroying the frame may destroy views and cancel more tasks, start over each time
+        unlink(*promise);
+        ++s_stats.cancelled;
+        Handle::from_promise(*promise).destroy();
+    }
+}
+
+// ==================== Scheduler ====================
+
+void DuiTask::ensureTimer() {
+    if (!s_timer) {
+        s_timer = lv_timer_create(tick, 1000, nullptr);
+        lv_timer_pause(s_timer);
+    }
+}
+
+// One timer for every task: due now when something is ready, otherwise at the earliest deadline
+void DuiTask::reschedule() {
+    if (!s_timer) {
+        return;
+    }
+    if (!s_ready.empty() || s_cancelPending) {
+        lv_timer_resume(s_timer);
+        lv_timer_ready(s_timer);
+        return;
+    }
+    if (s_sleeping.empty()) {
+        lv_timer_pause(s_timer);
+        return;
+    }
+    int32_t left = static_cast<int32_t>(s_sleeping.front()->m_deadline - lv_tick_get());
+    lv_timer_resume(s_timer);
+    if (left <= 0) {
+        lv_timer_ready(s_timer);
+    } else {
+        lv_timer_set_period(s_timer, static_cast<uint32_t>(left));
+        lv_timer_reset(s_timer);
+    }
+}
+
+void DuiTask::makeReady(Waiter& waiter) {
+    if (waiter.m_ready) {
+        return;
+    }
+    waiter.m_ready = true;
+    s_ready.push_back(&waiter);
+    ensureTimer();
+    lv_timer_resume(s_timer);
+    lv_timer_ready(s_timer);
+}
+
+void DuiTask::sleep(Waiter& waiter, uint32_t ms) {
+    waiter.m_deadline = lv_tick_get() + ms;
+    waiter.m_sleeping = true;
+    auto it = std::upper_bound(s_sleeping.begin(), s_sleeping.end(), &waiter, [](const Waiter* a, const Waiter* b) {
+        return isBefore(a->m_deadline, b->m_deadline);
+    });
+    bool earliest = it == s_sleeping.begin();
+    s_sleeping.insert(it, &waiter);
+    ensureTimer();
+    if (earliest) {
+        reschedule();
+    }
+}
+
+void DuiTask::tick(lv_timer_t* timer) {
+    (void)timer;
+    destroyCancelled();
+
+    uint32_t now = lv_tick_get();
+    std::size_t due = 0;
+    while (due < s_sleeping.size() && !isBefore(now, s_sleeping[due]->m_deadline)) {
+        Waiter* waiter = s_sleeping[due++];
+        waiter->m_sleeping = false;
+        waiter->m_ready = true;
+        s_ready.push_back(waiter);
+    }
+    s_sleeping.erase(s_sleeping.begin(), s_sleeping.begin() + due);
+
+    // Waiters made ready while resuming are handled in the same pass; a
+    // cancelled waiter nulls its slot, so its frame is never resumed
+    for (std::size_t i = 0; i < s_ready.size(); ++i) {
+        destroyCancelled();
+        Waiter* waiter = s_ready[i];
+        if (!waiter) {
+            continue;
+        }
+        s_ready[i] = nullptr;
+        waiter->m_ready = false;
+        ++s_stats.resumes;
+        waiter->m_handle.resume();
+    }
+    s_ready.clear();
+    destroyCancelled();
+    reschedule();
+}
+
+DuiTask::Waiter::~Waiter() {
+    if (m_ready) {
+        std::replace(s_ready.begin(), s_ready.end(), this, static_cast<Waiter*>(nullptr));
+    }
+    if (m_sleeping) {
+        s_sleeping.erase(std::find(s_sleeping.begin(), s_sleeping.end(), this));
+    }
+}
+
+// ==================== Awaiters ====================
+
+DuiTask::Delay DuiTask::delay(uint32_t ms) {
+    return Delay(ms);
+}
+
+void DuiTask::Delay::await_suspend(std::coroutine_handle<> handle) {
+    m_handle = handle;
+    sleep(*this, m_ms);
+}
+
+DuiTask::Event DuiTask::event(DuiViewBase& view, lv_event_code_t code) {
+    return Event(view, code);
+}
+
+DuiTask::Event::Event(DuiViewBase& view, lv_event_code_t code) : m_view(&view), m_obj(view.lvObject()), m_code(code) {}
+
+DuiTask::Event::~Event() {
+    stopListening();
+}
+
+void DuiTask::Event::await_suspend(std::coroutine_handle<> handle) {
+    m_handle = handle;
+    lv_obj_add_event_cb(m_obj, eventCb, m_code, this);
+    if (m_code != LV_EVENT_DELETE) {
+        lv_obj_add_event_cb(m_obj, eventCb, LV_EVENT_DELETE, this);
+    }
+    m_listening = true;
+    s_listening.push_back(this);
+}
+
+bool DuiTask::Event::await_resume() {
+    stopListening();
+    return m_fired;
+}
+
+// Only marks the task ready: it resumes from the scheduler timer, after the
+// event dispatch that removes our callbacks is over
+void DuiTask::Event::eventCb(lv_event_t* e) {
+    auto* event = static_cast<Event*>(lv_event_get_user_data(e));
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == event->m_code) {
+        event->m_fired = true;
+    }
+    if (code == LV_EVENT_DELETE) {
+        event->m_obj = nullptr; // LVGL frees our callbacks with the object
+        event->stopListening();
+    }
+    makeReady(*event);
+}
+
+void DuiTask::Event::stopListening() {
+    if (!m_listening) {
+        return;
+    }
+    m_listening = false;
+    if (m_obj) {
+        lv_obj_remove_event_cb_with_user_data(m_obj, eventCb, this);
+    }
+    s_listening.erase(std::find(s_listening.begin(), s_listening.end(), this));
+}
+
+DuiTask::Animation DuiTask::animate(const lv_anim_t& anim) {
+    return Animation(anim);
+}
+
+DuiTask::Animation DuiTask::animate(lv_obj_t* obj, lv_anim_exec_xcb_t exec, int32_t from, int32_t to, uint32_t ms) {
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, obj);
+    lv_anim_set_exec_cb(&anim, exec);
+    lv_anim_set_values(&anim, from, to);
+    lv_anim_set_duration(&anim, ms);
+    return Animation(anim);
+}
+
+DuiTask::Animation::~Animation() {
+    if (m_running) {
+        // LVGL identifies a running animation by its variable and exec callback
+        m_cancelling = true;
+        if (m_anim.exec_cb) {
+            lv_anim_delete(m_anim.var, m_anim.exec_cb);
+        } else {
+            lv_anim_custom_delete(&m_anim, m_anim.custom_exec_cb);
+        }
+    }
+}
+
+void DuiTask::Animation::await_suspend(std::coroutine_handle<> handle) {
+    m_handle = handle;
+    lv_anim_set_user_data(&m_anim, this);
+    lv_anim_set_completed_cb(&m_anim, completedCb);
+    lv_anim_set_deleted_cb(&m_anim, deletedCb);
+    m_running = true;
+    lv_anim_start(&m_anim);
+}
+
+void DuiTask::Animation::completedCb(lv_anim_t* anim) {
+    static_cast<Animation*>(lv_anim_get_user_data(anim))->m_completed = true;
+}
+
+// Called after completedCb when the animation ends, and alone when it is deleted
+void DuiTask::Animation::deletedCb(lv_anim_t* anim) {
+    auto* animation = static_cast<Animation*>(lv_anim_get_user_data(anim));
+    animation->m_running = false;
+    if (!animation->m_cancelling) {
+        makeReady(*animation);
+    }
+}
+
+// ==================== Frame pool ====================
+
+void* DuiTask::allocateFrame(std::size_t size) {
+    ++s_stats.frameAllocs;
+    std::size_t sizeClass = (size + FrameGranule - 1) / FrameGranule;
+    if (sizeClass > PooledClasses) {
+        return ::operator new(size);
+    }
+    if (FreeFrame* frame = freeFrames[sizeClass]) {
+        freeFrames[sizeClass] = frame->next;
+        s_stats.pooledBytes -= sizeClass * FrameGranule;
+        ++s_stats.frameReuses;
+        return frame;
+    }
+    return ::operator new(sizeClass * FrameGranule);
+}
+
+void DuiTask::releaseFrame(void* frame, std::size_t size) {
+    std::size_t sizeClass = (size + FrameGranule - 1) / FrameGranule;
+    if (sizeClass <= PooledClasses && s_stats.pooledBytes + sizeClass * FrameGranule <= PoolBudget) {
+        freeFrames[sizeClass] = new (frame) FreeFrame{freeFrames[sizeClass]};
+        s_stats.pooledBytes += sizeClass * FrameGranule;
+        return;
+    }
+    ::operator delete(frame);
+}
+
+void DuiTask::trimPool() {
+    for (FreeFrame*& head : freeFrames) {
+        while (FreeFrame* frame = head) {
+            head = frame->next;
+            ::operator delete(frame);
+        }
+    }
+    s_stats.pooledBytes = 0;
+}
+
+const DuiTaskStats& DuiTask::stats() {
+    return s_stats;
+}
+
+void DuiTask::resetStats() {
+    std::size_t pooled = s_stats.pooledBytes;
+    s_stats = DuiTaskStats{};
+    s_stats.pooledBytes = pooled;
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "lvgl.h"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+class DuiViewBase;
+
+// Counters of the coroutine scheduler and its frame pool
+struct DuiTaskStats {
+    uint64_t started = 0;     // Tasks that began running
+    uint64_t completed = 0;   // Tasks that ran to the end
+    uint64_t cancelled = 0;   // Frames destroyed at a suspension point
+    uint64_t resumes = 0;     // Resumptions issued by the scheduler timer
+    uint64_t frameAllocs = 0; // Coroutine frames allocated
+    uint64_t frameReuses = 0; // Of those, frames taken from the pool
+    std::size_t pooledBytes = 0;
+};
+
+// Coroutine returned by UI flows: co_await DuiTask::delay(300),
+// co_await button.clicked(), co_await DuiTask::animate(anim) or another task
+//
+// Tasks run on the UI thread only. Every suspended task is resumed by one
+// lv_timer owned by the scheduler, from lv_timer_handler(), so no thread and
+// no per-step callback object is involved: the awaiters live inside the
+// coroutine frame, and frames come from a small size-class pool.
+//
+// A task starts lazily. Either keep the DuiTask and call start(), the frame
+// then lives until the DuiTask is destroyed, or hand it to spawn(owner, ...):
+// the task then frees itself when it finishes and is cancelled when the
+// owner view is destroyed, a moved owner hands it on. Cancelling destroys
+// the frame at its suspension point; the awaiters' destructors stop their
+// timers, event callbacks and animations. Parameters taken by reference
+// must outlive the task.
+class DuiTask {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class Waiter;
+    class Delay;
+    class Event;
+    class Animation;
+
+    DuiTask() = default;
+    DuiTask(DuiTask&& other) noexcept;
+    DuiTask& operator=(DuiTask&& other) noexcept;
+    ~DuiTask();
+
+    // Run until the first suspension
+    void start();
+    // Destroy the frame; a no-op for finished or spawned tasks
+    void cancel();
+    bool done() const;
+
+    // Run a task that frees itself when it finishes; cancelled together with owner
+    static void spawn(DuiViewBase& owner, DuiTask task);
+    static void spawn(DuiTask task);
+
+    // Called by ~DuiViewBase: cancel the tasks owned by view and wake the
+    // tasks waiting for its events, their co_await yields false
+    static void forget(const DuiViewBase& view);
+    // Called by DuiViewBase's move constructor: the tasks owned by from and
+    // waiting for its events now belong to to
+    static void retarget(const DuiViewBase& from, const DuiViewBase& to);
+
+    // Resume after ms milliseconds, delay(0) yields until the next timer pass
+    static Delay delay(uint32_t ms);
+    // Resume at the next event of the view's object, e.g. LV_EVENT_CLICKED
+    static Event event(DuiViewBase& view, lv_event_code_t code);
+    // Start the animation and resume when it ends; user_data and the
+    // completed/deleted callbacks of anim are taken by the task
+    static Animation animate(const lv_anim_t& anim);
+    static Animation animate(lv_obj_t* obj, lv_anim_exec_xcb_t exec, int32_t from, int32_t to, uint32_t ms);
+
+    // co_await of a task runs it and resumes the caller when it finishes
+    class Awaiter;
+    Awaiter operator co_await() && noexcept;
+
+    static const DuiTaskStats& stats();
+    static void resetStats();
+    // Free the pooled coroutine frames
+    static void trimPool();
+
+private:
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle handle) noexcept;
+        void await_resume() noexcept {}
+    };
+
+    explicit DuiTask(Handle handle) : m_handle(handle) {}
+
+    static void adopt(DuiTask& task, const DuiViewBase* owner);
+    static void link(promise_type& promise);
+    static void unlink(promise_type& promise);
+    static void destroyCancelled();
+
+    // Scheduler
+    static void ensureTimer();
+    static void reschedule();
+    static void makeReady(Waiter& waiter);
+    static void sleep(Waiter& waiter, uint32_t ms);
+    static void tick(lv_timer_t* timer);
+
+    static void* allocateFrame(std::size_t size);
+    static void releaseFrame(void* frame, std::size_t size);
+
+    Handle m_handle;
+
+    static lv_timer_t* s_timer;
+    static std::vector<Waiter*> s_ready;    // Resumed at the next timer pass
+    static std::vector<Waiter*> s_sleeping; // Sorted by deadline
+    static std::vector<Event*> s_listening;
+    static promise_type* s_spawned;         // Intrusive list of spawned tasks
+    static std::size_t s_cancelPending;     // Spawned tasks waiting to be destroyed
+    static DuiTaskStats s_stats;
+};
+
+struct DuiTask::promise_type {
+    DuiTask get_return_object() noexcept {
+        return DuiTask(Handle::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept {
+        return {};
+    }
+    FinalAwaiter final_suspend() noexcept {
+        return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    static void* operator new(std::size_t size) {
+        return DuiTask::allocateFrame(size);
+    }
+    static void operator delete(void* frame, std::size_t size) {
+        DuiTask::releaseFrame(frame, size);
+    }
+
+    std::coroutine_handle<> continuation; // Task awaiting this one
+    std::exception_ptr exception;
+    const DuiViewBase* owner = nullptr;
+    promise_type* prev = nullptr;
+    promise_type* next = nullptr;
+    bool started = false;
+    bool spawned = false;
+    bool cancelPending = false;
+};
+
+// Common part of the awaiters: a suspended handle the scheduler resumes
+class DuiTask::Waiter {
+public:
+    Waiter(const Waiter&) = delete;
+    Waiter& operator=(const Waiter&) = delete;
+
+protected:
+    Waiter() = default;
+    // Leaves the scheduler's queues, so a cancelled frame is never resumed
+    ~Waiter();
+
+    std::coroutine_handle<> m_handle;
+    uint32_t m_deadline = 0;
+    bool m_ready = false;
+    bool m_sleeping = false;
+
+    friend class DuiTask;
+};
+
+class DuiTask::Delay : public Waiter {
+public:
+    explicit Delay(uint32_t ms) : m_ms(ms) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle);
+    void await_resume() const noexcept {}
+
+private:
+    uint32_t m_ms;
+};
+
+class DuiTask::Event : public Waiter {
+public:
+    Event(DuiViewBase& view, lv_event_code_t code);
+    ~Event();
+
+    // A view that is not built has no events, the await yields false at once
+    bool await_ready() const noexcept {
+        return !m_obj;
+    }
+    void await_suspend(std::coroutine_handle<> handle);
+    // false when the view or its object was destroyed first
+    bool await_resume();
+
+private:
+    static void eventCb(lv_event_t* e);
+    void stopListening();
+
+    const DuiViewBase* m_view;
+    lv_obj_t* m_obj;
+    lv_event_code_t m_code;
+    bool m_fired = false;
+    bool m_listening = false;
+
+    friend class DuiTask;
+};
+
+class DuiTask::Animation : public Waiter {
+public:
+    explicit Animation(const lv_anim_t& anim) : m_anim(anim) {}
+    ~Animation();
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle);
+    // false when the animation was deleted before it completed
+    bool await_resume() const noexcept {
+        return m_completed;
+    }
+
+private:
+    static void completedCb(lv_anim_t* anim);
+    static void deletedCb(lv_anim_t* anim);
+
+    lv_anim_t m_anim;
+    bool m_running = false;
+    bool m_completed = false;
+    bool m_cancelling = false;
+};
+
+class DuiTask::Awaiter {
+public:
+    explicit Awaiter(Handle handle) : m_handle(handle) {}
+
+    bool await_ready() const noexcept {
+        return !m_handle || m_handle.done();
+    }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept;
+    // Rethrows what escaped the awaited task
+    void await_resume() const;
+
+private:
+    Handle m_handle;
+};
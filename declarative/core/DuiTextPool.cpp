@@ -0,0 +1,43 @@
+#include "DuiTextPool.h"
+#include <functional>
+#include <unordered_set>
+
+namespace {
+
+struct TextHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view text) const {
+        return std::hash<std::string_view>{}(text);
+    }
+};
+
+// Node based, so the strings never move once inserted
+struct Pool {
+    std::unordered_set<std::string, TextHash, std::equal_to<>> strings;
+    std::size_t bytes = 0;
+};
+
+Pool& pool() {
+    static Pool instance;
+    return instance;
+}
+
+} // namespace
+
+const char* DuiTextPool::intern(std::string_view text) {
+    Pool& p = pool();
+    auto it = p.strings.find(text);
+    if (it == p.strings.end()) {
+        it = p.strings.emplace(text).first;
+        p.bytes += text.size() + 1;
+    }
+    return it->c_str();
+}
+
+std::size_t DuiTextPool::size() {
+    return pool().strings.size();
+}
+
+std::size_t DuiTextPool::bytes() {
+    return pool().bytes;
+}
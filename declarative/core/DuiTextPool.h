@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Process-wide pool of interned label strings
+//
+// Equal strings share one stable, null-terminated copy that lives until
+// exit, so labels can display it with lv_label_set_text_static. Meant for a
+// bounded vocabulary (status words, units, menu entries), not for
+// free-running values.
+class DuiTextPool {
+public:
+    static const char* intern(std::string_view text);
+
+    static std::size_t size();
+    static std::size_t bytes();
+};
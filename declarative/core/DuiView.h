@@ -1,13 +1,44 @@
 #pragma once
 
 #include "DuiViewBase.h"
+#include "DuiMemory.h"
+#include <string>
+#include <string_view>
+#include <utility>
 
 template <typename Derived>
 class DuiView : public DuiViewBase {
 public:
-    // Modifiers
+    using DuiViewBase::key;
+    using DuiViewBase::objectName;
+
+    // Derived::TypeName names the view type in memory reports
+    void accountMemory(DuiMemoryWalker& walker) const override {
+        walker.add(*this, Derived::TypeName, sizeof(Derived) + this->heapBytes());
+    }
+
+    // Reconciler identity, unique among siblings
+    Derived& key(std::string k) & {
+        m_key = std::move(k);
+        return static_cast<Derived&>(*this);
+    }
+    Derived&& key(std::string k) && {
+        return std::move(key(std::move(k)));
+    }
+
+    // Name to find the view by, see DuiObject::findByName()
+    Derived& objectName(std::string_view name) & {
+        setObjectName(name);
+        return static_cast<Derived&>(*this);
+    }
+    Derived&& objectName(std::string_view name) && {
+        return std::move(objectName(name));
+    }
+
+    // Modifiers, recorded in the property record and committed in batches
     Derived& width(int w) & {
-        lv_obj_set_width(m_lvObject, w);
+        m_props.width = w;
+        markDirty(DuiProps::Width);
         return static_cast<Derived&>(*this);
     }
     Derived&& width(int w) && {
@@ -15,7 +46,8 @@ public:
     }
 
     Derived& height(int h) & {
-        lv_obj_set_height(m_lvObject, h);
+        m_props.height = h;
+        markDirty(DuiProps::Height);
         return static_cast<Derived&>(*this);
     }
     Derived&& height(int h) && {
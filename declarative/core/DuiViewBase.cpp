@@ -1,19 +1,150 @@
 #include "DuiViewBase.h"
+#include "DuiFlushQueue.h"
+#include "DuiMutationQueue.h"
+#include "DuiTask.h"
+#include "DuiSnapshot.h"
+#include "DuiMemory.h"
 
 DuiViewBase::DuiViewBase(DuiViewBase* parent) : m_parent(parent) {}
 
 DuiViewBase::~DuiViewBase() {
-    if (m_lvObject) {
+    DuiFlushQueue::cancel(*this);
+    DuiMutationQueue::forget(*this);
+    DuiTask::forget(*this);
+
+    // The root view owns the LVGL subtree: one lv_obj_del frees every
+    // descendant, so child views leave their objects to it
+    if (m_lvObject && !m_parent) {
         lv_obj_del(m_lvObject);
         m_lvObject = nullptr;
     }
 }
 
 DuiViewBase::DuiViewBase(DuiViewBase&& other) noexcept
-    : DuiObject(std::move(other)), m_lvObject(other.m_lvObject), m_parent(other.m_parent) {
+    : DuiObject(std::move(other)), m_lvObject(other.m_lvObject), m_parent(other.m_parent),
+      m_props(other.m_props), m_key(std::move(other.m_key)) {
     other.m_lvObject = nullptr;
+    DuiFlushQueue::retarget(other, *this);
+    DuiMutationQueue::retarget(other, *this);
+    DuiTask::retarget(other, *this);
+}
+
+lv_obj_t* DuiViewBase::_build(lv_obj_t* parent) {
+    if (m_lvObject) {
+        return m_lvObject;
+    }
+
+    // Every lv_*_create and setter invalidates its area. Hold invalidation off
+    // for the whole pass and invalidate the finished subtree once instead.
+    // Layout is computed lazily by LVGL, so it runs once at the next refresh.
+    lv_display_t* disp = parent ? lv_obj_get_display(parent) : lv_display_get_default();
+    bool invalidationEnabled = disp && lv_display_is_invalidation_enabled(disp);
+    if (invalidationEnabled) {
+        lv_display_enable_invalidation(disp, false);
+    }
+
+    materialize(*this, parent);
+
+    if (invalidationEnabled) {
+        lv_display_enable_invalidation(disp, true);
+        lv_obj_invalidate(m_lvObject);
+    }
+    return m_lvObject;
 }
 
 lv_obj_t* DuiViewBase::lvObject() const {
     return m_lvObject;
 }
+
+bool DuiViewBase::isBuilt() const {
+    return m_lvObject != nullptr;
+}
+
+DuiViewBase* DuiViewBase::parentView() const {
+    return m_parent;
+}
+
+DuiEventDelegate* DuiViewBase::eventDelegate() {
+    return nullptr;
+}
+
+void DuiViewBase::snapshot(DuiSnapshotWriter& writer) const {
+    writer.add(DuiSnapshotType::Object, m_props, m_key);
+}
+
+void DuiViewBase::accountMemory(DuiMemoryWalker& walker) const {
+    walker.add(*this, "DuiViewBase", sizeof(DuiViewBase) + heapBytes());
+}
+
+std::size_t DuiViewBase::heapBytes() const {
+    // The name is an id into DuiNameTable, shared by every object with that name
+    return DuiMemory::stringBytes(m_key);
+}
+
+bool DuiViewBase::isArenaAllocated() const {
+    return m_arenaAllocated;
+}
+
+const std::string& DuiViewBase::key() const {
+    return m_key;
+}
+
+void DuiViewBase::flushProperties() {
+    DuiFlushQueue::cancel(*this);
+    if (m_lvObject && m_props.dirty) {
+        uint32_t dirty = m_props.dirty;
+        m_props.dirty = 0;
+        applyProperties(dirty);
+    }
+}
+
+void DuiViewBase::applyProperties(uint32_t fields) {
+    if ((fields & DuiProps::LayoutFields) == DuiProps::LayoutFields) {
+        lv_obj_set_size(m_lvObject, m_props.width, m_props.height);
+    } else if (fields & DuiProps::Width) {
+        lv_obj_set_width(m_lvObject, m_props.width);
+    } else if (fields & DuiProps::Height) {
+        lv_obj_set_height(m_lvObject, m_props.height);
+    }
+}
+
+void DuiViewBase::markDirty(uint32_t fields) {
+    m_props.mark(fields);
+    if (m_lvObject) {
+        DuiFlushQueue::countModifier();
+        DuiFlushQueue::schedule(*this);
+    }
+}
+
+bool DuiViewBase::updateFrom(DuiViewBase& next) {
+    uint32_t changed = m_props.assign(next.m_props);
+    if (changed) {
+        markDirty(changed);
+    }
+    return changed != 0;
+}
+
+void DuiViewBase::buildChildren() {}
+
+void DuiViewBase::materialize(DuiViewBase& view, lv_obj_t* parent) {
+    view.m_lvObject = view.createObject(parent);
+    view.m_props.dirty = 0;
+    view.applyProperties(view.m_props.set);
+    view.buildChildren();
+}
+
+void DuiViewBase::attach(DuiViewBase& child, DuiViewBase* parent) {
+    child.m_parent = parent;
+}
+
+bool DuiViewBase::updateChild(DuiViewBase& child, DuiViewBase& next) {
+    return child.updateFrom(next);
+}
+
+void DuiNodeDeleter::operator()(DuiViewBase* node) const {
+    if (node->isArenaAllocated()) {
+        node->~DuiViewBase(); // The arena releases the memory in bulk
+    } else {
+        delete node;
+    }
+}
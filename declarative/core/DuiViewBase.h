@@ -1,9 +1,32 @@
 #pragma once
 
 #include "DuiObject.h"
+#include "DuiProps.h"
 #include "lvgl.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class DuiViewBase;
+class DuiArena;
+class DuiEventDelegate;
+class DuiSnapshotWriter;
+class DuiMemoryWalker;
+
+// Destroys a node, either in place (arena) or with delete (heap)
+struct DuiNodeDeleter {
+    void operator()(DuiViewBase* node) const;
+};
+
+// Owning handle of a child node; the memory may belong to a DuiArena
+using DuiNodePtr = std::unique_ptr<DuiViewBase, DuiNodeDeleter>;
 
 // The common, non-template base class for all views
+//
+// Views are built in two phases: constructors and modifiers only record a
+// description of the view, and _build() materializes the whole tree in one
+// pass, creating every lv_obj_t directly under its final parent.
 class DuiViewBase : public DuiObject {
 public:
     explicit DuiViewBase(DuiViewBase* parent = nullptr);
@@ -11,9 +34,62 @@ public:
 
     DuiViewBase(DuiViewBase&& other) noexcept;
 
+    // Materialize this view and its subtree under parent (no-op once built)
+    lv_obj_t* _build(lv_obj_t* parent);
+
     lv_obj_t* lvObject() const;
+    bool isBuilt() const;
+    DuiViewBase* parentView() const;
+    bool isArenaAllocated() const;
+
+    // Identity used by the reconciler to match children across rebuilds
+    const std::string& key() const;
+
+    // Push this node's pending modifiers now instead of at the next frame
+    void flushProperties();
+
+    // Click handler shared by this view's subtree, null unless the view delegates events
+    virtual DuiEventDelegate* eventDelegate();
+
+    // Record this view and its subtree into a DuiSnapshot
+    virtual void snapshot(DuiSnapshotWriter& writer) const;
+
+    // Record this view and its subtree into a DuiMemory report
+    virtual void accountMemory(DuiMemoryWalker& walker) const;
 
 protected:
+    // Create the bare LVGL object of this view under its final parent
+    virtual lv_obj_t* createObject(lv_obj_t* parent) = 0;
+    // Push the given recorded fields to the LVGL object
+    virtual void applyProperties(uint32_t fields);
+    // Record a modifier; built nodes are queued for the next frame flush
+    void markDirty(uint32_t fields);
+    // Take over the description of a new view of the same type, return true if anything changed
+    virtual bool updateFrom(DuiViewBase& next);
+    // Materialize child views, only containers have any
+    virtual void buildChildren();
+    // C++ heap bytes owned by this view beyond its own object
+    virtual std::size_t heapBytes() const;
+
+    // Helpers for containers, which cannot reach protected members of other views
+    static void materialize(DuiViewBase& view, lv_obj_t* parent);
+    static void attach(DuiViewBase& child, DuiViewBase* parent);
+    static bool updateChild(DuiViewBase& child, DuiViewBase& next);
+
     lv_obj_t* m_lvObject = nullptr;
     DuiViewBase* m_parent = nullptr;
+
+    // Recorded modifiers, applied when the object is materialized
+    DuiProps m_props;
+    std::string m_key;
+
+private:
+    friend class DuiArena;
+    friend class DuiFlushQueue;
+    friend class DuiMutationQueue;
+    friend class DuiReconciler;
+    bool m_arenaAllocated = false;
+    int16_t m_flushQueue = -1; // Display queue in DuiFlushQueue
+    int32_t m_flushSlot = -1;
+    std::atomic<uint32_t> m_postHandle{0}; // Set by the first DuiMutationQueue::post to this view
 };
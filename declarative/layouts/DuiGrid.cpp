@@ -0,0 +1,222 @@
+#include "DuiGrid.h"
+#include "lvgl.h"
+#include <algorithm>
+#include <map>
+
+namespace {
+
+// Keyed by the descriptor values; node based, so a template never moves once added
+std::map<std::vector<int32_t>, DuiGridTracks>& templates() {
+    static std::map<std::vector<int32_t>, DuiGridTracks> instance;
+    return instance;
+}
+
+lv_grid_align_t lvAlign(DuiGridAlign align) {
+    switch (align) {
+    case DuiGridAlign::Start:
+        return LV_GRID_ALIGN_START;
+    case DuiGridAlign::Center:
+        return LV_GRID_ALIGN_CENTER;
+    case DuiGridAlign::End:
+        return LV_GRID_ALIGN_END;
+    default:
+        return LV_GRID_ALIGN_STRETCH;
+    }
+}
+
+// Cells outside the template are pulled back onto its last track
+void clampSpan(uint16_t& first, uint16_t& span, std::size_t count) {
+    if (first + span > count) {
+        LV_LOG_WARN("DuiGrid: cell at track %u, span %u outside %zu tracks", unsigned(first), unsigned(span), count);
+        first = static_cast<uint16_t>(std::min<std::size_t>(first, count - 1));
+        span = static_cast<uint16_t>(count - first);
+    }
+    span = std::max<uint16_t>(span, 1);
+}
+
+// Position (and size when stretched) of a child along one axis of its cell:
+// start and length of the cell from the track offsets, then a translation
+// relative to the child's own size for the alignments that depend on it
+struct Placement {
+    int32_t pos;
+    int32_t size;       // Cell length, used when stretched
+    int32_t translate;  // LV_PCT of the child's size, 0 for start and stretch
+};
+
+Placement place(const DuiGridTracks& tracks, uint16_t first, uint16_t span, int32_t gap, DuiGridAlign align) {
+    int32_t start = tracks.offsets[first] + first * gap;
+    int32_t end = tracks.offsets[first + span] + (first + span - 1) * gap;
+    switch (align) {
+    case DuiGridAlign::Center:
+        return {(start + end) / 2, end - start, LV_PCT(-50)};
+    case DuiGridAlign::End:
+        return {end, end - start, LV_PCT(-100)};
+    default:
+        return {start, end - start, 0};
+    }
+}
+
+} // namespace
+
+DuiGrid::DuiGrid(const std::vector<DuiGridTrack>& columns, const std::vector<DuiGridTrack>& rows,
+                 const ContentBuilder& builder)
+    : m_columns(intern(columns)), m_rows(intern(rows)) {
+    if (!builder) {
+        return;
+    }
+    DuiGridChildList children(m_columns->count());
+    builder(children);
+    m_children.reserve(children.nodes().size());
+    m_cells = std::move(children.cells());
+    for (auto& child : children.nodes()) {
+        DuiViewBase::attach(*child, this);
+        m_children.push_back(std::move(child));
+    }
+}
+
+void DuiGrid::addChild(const DuiGridCell& cell, DuiNodePtr child) {
+    m_cells.push_back(cell);
+    DuiContainer::addChild(std::move(child));
+    if (m_lvObject) {
+        placeChild(m_children.size() - 1, false);
+    }
+}
+
+void DuiGrid::addChild(DuiNodePtr child) {
+    std::size_t index = m_children.size();
+    std::size_t columns = m_columns->count();
+    addChild(DuiGridCell(static_cast<uint16_t>(index % columns), static_cast<uint16_t>(index / columns)),
+             std::move(child));
+}
+
+const DuiGridCell& DuiGrid::cellAt(std::size_t index) const {
+    return m_cells[index];
+}
+
+bool DuiGrid::isFixed() const {
+    return m_columns->fixed && m_rows->fixed;
+}
+
+void DuiGrid::snapshot(DuiSnapshotWriter& writer) const {
+    writer.add(SnapshotType, m_props, m_key);
+}
+
+std::size_t DuiGrid::templateCount() {
+    return templates().size();
+}
+
+const DuiGridTracks* DuiGrid::intern(const std::vector<DuiGridTrack>& tracks) {
+    std::vector<int32_t> key;
+    key.reserve(tracks.size() + 1);
+    for (const DuiGridTrack& track : tracks) {
+        key.push_back(track.value);
+    }
+    // A grid needs at least one track per axis
+    if (key.empty()) {
+        key.push_back(LV_GRID_FR(1));
+    }
+
+    auto [it, inserted] = templates().try_emplace(key);
+    DuiGridTracks& entry = it->second;
+    if (inserted) {
+        entry.dsc = key;
+        entry.dsc.push_back(LV_GRID_TEMPLATE_LAST);
+        entry.offsets.reserve(key.size() + 1);
+        int32_t offset = 0;
+        for (int32_t value : key) {
+            entry.offsets.push_back(offset);
+            entry.fixed = entry.fixed && value >= 0 && value < LV_GRID_CONTENT;
+            offset += value;
+        }
+        entry.offsets.push_back(offset);
+        if (!entry.fixed) {
+            entry.offsets.clear();
+        }
+    }
+    return &entry;
+}
+
+lv_obj_t* DuiGrid::createObject(lv_obj_t* parent) {
+    lv_obj_t* obj = lv_obj_create(parent);
+    lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+    return obj;
+}
+
+void DuiGrid::buildChildren() {
+    applyTemplate();
+    DuiContainer::buildChildren();
+    for (std::size_t i = 0; i < m_children.size(); ++i) {
+        placeChild(i, false);
+    }
+}
+
+void DuiGrid::applyTemplate() {
+    if (isFixed()) {
+        lv_obj_set_layout(m_lvObject, LV_LAYOUT_NONE);
+    } else {
+        lv_obj_set_grid_dsc_array(m_lvObject, m_columns->dsc.data(), m_rows->dsc.data());
+        lv_obj_set_layout(m_lvObject, LV_LAYOUT_GRID);
+    }
+}
+
+// replace: the child was placed before, under another cell or template
+void DuiGrid::placeChild(std::size_t index, bool replace) {
+    DuiGridCell cell = m_cells[index];
+    clampSpan(cell.column, cell.columnSpan, m_columns->count());
+    clampSpan(cell.row, cell.rowSpan, m_rows->count());
+    lv_obj_t* obj = m_children[index]->lvObject();
+
+    if (!isFixed()) {
+        if (replace) {
+            lv_obj_set_style_translate_x(obj, 0, LV_PART_MAIN);
+            lv_obj_set_style_translate_y(obj, 0, LV_PART_MAIN);
+        }
+        lv_obj_set_grid_cell(obj, lvAlign(cell.x), cell.column, cell.columnSpan, lvAlign(cell.y), cell.row,
+                             cell.rowSpan);
+        return;
+    }
+
+    int32_t columnGap = lv_obj_get_style_pad_column(m_lvObject, LV_PART_MAIN);
+    int32_t rowGap = lv_obj_get_style_pad_row(m_lvObject, LV_PART_MAIN);
+    Placement x = place(*m_columns, cell.column, cell.columnSpan, columnGap, cell.x);
+    Placement y = place(*m_rows, cell.row, cell.rowSpan, rowGap, cell.y);
+    lv_obj_set_pos(obj, x.pos, y.pos);
+    if (x.translate || replace) {
+        lv_obj_set_style_translate_x(obj, x.translate, LV_PART_MAIN);
+    }
+    if (y.translate || replace) {
+        lv_obj_set_style_translate_y(obj, y.translate, LV_PART_MAIN);
+    }
+    // A child that leaves a stretched cell keeps the stretched size
+    if (cell.x == DuiGridAlign::Stretch) {
+        lv_obj_set_width(obj, x.size);
+    }
+    if (cell.y == DuiGridAlign::Stretch) {
+        lv_obj_set_height(obj, y.size);
+    }
+}
+
+bool DuiGrid::updateFrom(DuiViewBase& next) {
+    auto& other = static_cast<DuiGrid&>(next);
+    bool changed = DuiContainer::updateFrom(next);
+    bool templateChanged = m_columns != other.m_columns || m_rows != other.m_rows;
+    bool cellsChanged = m_cells != other.m_cells;
+    m_columns = other.m_columns;
+    m_rows = other.m_rows;
+    m_cells = std::move(other.m_cells);
+
+    // The reconciler has put the children in the order of the new cells
+    if (m_lvObject && (changed || templateChanged || cellsChanged)) {
+        if (templateChanged) {
+            applyTemplate();
+        }
+        for (std::size_t i = 0; i < m_children.size(); ++i) {
+            placeChild(i, true);
+        }
+    }
+    return changed || templateChanged || cellsChanged;
+}
+
+std::size_t DuiGrid::heapBytes() const {
+    return DuiContainer::heapBytes() + m_cells.capacity() * sizeof(DuiGridCell);
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "core/DuiContainer.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// One column or row of a DuiGrid template
+struct DuiGridTrack {
+    static DuiGridTrack fixed(int32_t px) {
+        return {px};
+    }
+    // Share of the space left by the other tracks
+    static DuiGridTrack fr(uint8_t weight) {
+        return {LV_GRID_FR(weight)};
+    }
+    // As large as the largest child in the track
+    static DuiGridTrack content() {
+        return {LV_GRID_CONTENT};
+    }
+
+    int32_t value; // LVGL grid descriptor value
+};
+
+enum class DuiGridAlign : uint8_t {
+    Start,
+    Center,
+    End,
+    Stretch,
+};
+
+// Placement of a child: its first column and row, spans and alignment in the cell
+struct DuiGridCell {
+    uint16_t column = 0;
+    uint16_t row = 0;
+    uint16_t columnSpan = 1;
+    uint16_t rowSpan = 1;
+    DuiGridAlign x = DuiGridAlign::Stretch;
+    DuiGridAlign y = DuiGridAlign::Stretch;
+
+    DuiGridCell() = default;
+    DuiGridCell(uint16_t column, uint16_t row) : column(column), row(row) {}
+
+    DuiGridCell& span(uint16_t columns, uint16_t rows) {
+        columnSpan = columns;
+        rowSpan = rows;
+        return *this;
+    }
+    DuiGridCell& align(DuiGridAlign horizontal, DuiGridAlign vertical) {
+        x = horizontal;
+        y = vertical;
+        return *this;
+    }
+
+    bool operator==(const DuiGridCell&) const = default;
+};
+
+// Interned track template: grids with the same tracks share one LVGL descriptor
+struct DuiGridTracks {
+    std::vector<int32_t> dsc;     // Terminated by LV_GRID_TEMPLATE_LAST, as LVGL expects
+    std::vector<int32_t> offsets; // Start of each track and the total, gaps excluded; fixed templates only
+    bool fixed = true;
+
+    std::size_t count() const {
+        return dsc.size() - 1;
+    }
+};
+
+// Collects the children of a DuiGrid with their cells
+class DuiGridChildList {
+public:
+    explicit DuiGridChildList(std::size_t columns) : m_columns(columns ? columns : 1) {}
+
+    template<typename T>
+        requires std::is_base_of_v<DuiViewBase, std::remove_cvref_t<T>>
+    void operator()(const DuiGridCell& cell, T&& view) {
+        m_nodes.push_back(DuiArena::makeNode(std::move(view)));
+        m_cells.push_back(cell);
+    }
+
+    // The next cell in row-major order
+    template<typename T>
+        requires std::is_base_of_v<DuiViewBase, std::remove_cvref_t<T>>
+    void operator()(T&& view) {
+        std::size_t index = m_nodes.size();
+        (*this)(DuiGridCell(static_cast<uint16_t>(index % m_columns), static_cast<uint16_t>(index / m_columns)),
+                std::move(view));
+    }
+
+    std::vector<DuiNodePtr>& nodes() {
+        return m_nodes;
+    }
+    std::vector<DuiGridCell>& cells() {
+        return m_cells;
+    }
+
+private:
+    std::size_t m_columns;
+    std::vector<DuiNodePtr> m_nodes;
+    std::vector<DuiGridCell> m_cells;
+};
+
+// Grid container on LVGL's grid layout
+//
+// Columns and rows are fixed, fractional (fr) or content-sized tracks;
+// children take a cell with optional spans and an alignment in the cell.
+// One grid replaces the rows of nested stacks a dashboard would otherwise
+// need, with half the objects. Track templates are interned: every grid with
+// the same tracks points LVGL at the same descriptor arrays, which live
+// until exit.
+//
+// When every column and row is fixed the grid runs no layout at all: each
+// cell's rectangle is known from the track offsets, so a child gets its
+// position (and its size, when stretched) once; centered and end-aligned
+// children are shifted by a translation relative to their own size, which
+// LVGL keeps right when their content changes. The gaps are the grid's
+// pad_column and pad_row when the children are placed. Other templates use
+// LV_LAYOUT_GRID. Like the stacks, the grid fills its parent unless it is
+// given a width or height.
+class DuiGrid : public DuiContainer<DuiGrid> {
+public:
+    using ContentBuilder = std::function<void(DuiGridChildList&)>;
+    static constexpr DuiSnapshotType SnapshotType = DuiSnapshotType::Object;
+    static constexpr const char* TypeName = "DuiGrid";
+
+    DuiGrid(const std::vector<DuiGridTrack>& columns, const std::vector<DuiGridTrack>& rows,
+            const ContentBuilder& builder = {});
+    DuiGrid(DuiGrid&&) = default;
+
+    // Add a child in the given cell, or in the next cell in row-major order
+    void addChild(const DuiGridCell& cell, DuiNodePtr child);
+    void addChild(DuiNodePtr child);
+    template<typename T>
+        requires std::is_base_of_v<DuiViewBase, std::remove_cvref_t<T>>
+    void addChild(const DuiGridCell& cell, T&& view) {
+        addChild(cell, DuiArena::makeNode(std::move(view)));
+    }
+    template<typename T>
+        requires std::is_base_of_v<DuiViewBase, std::remove_cvref_t<T>>
+    void addChild(T&& view) {
+        addChild(DuiArena::makeNode(std::move(view)));
+    }
+
+    const DuiGridCell& cellAt(std::size_t index) const;
+    // Both templates fixed: cells are placed without a grid layout
+    bool isFixed() const;
+
+    // A snapshot keeps the grid as a plain object, without its children
+    void snapshot(DuiSnapshotWriter& writer) const override;
+
+    // Number of distinct track templates in use by all grids
+    static std::size_t templateCount();
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override;
+    void buildChildren() override;
+    bool updateFrom(DuiViewBase& next) override;
+    std::size_t heapBytes() const override;
+
+private:
+    static const DuiGridTracks* intern(const std::vector<DuiGridTrack>& tracks);
+    void applyTemplate();
+    void placeChild(std::size_t index, bool replace);
+
+    const DuiGridTracks* m_columns;
+    const DuiGridTracks* m_rows;
+    std::vector<DuiGridCell> m_cells; // Parallel to m_children
+};
@@ -1,21 +1,46 @@
 #include "DuiHStack.h"
+#include "DuiStackLayout.h"
 #include "lvgl.h"
 
-DuiHStack::DuiHStack() {
-    m_lvObject = lv_obj_create(lv_scr_act());
-    lv_obj_set_size(m_lvObject, LV_PCT(100), LV_PCT(100));
-    lv_obj_set_layout(m_lvObject, LV_LAYOUT_FLEX);
-    lv_obj_set_flex_flow(m_lvObject, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(m_lvObject, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+DuiHStack::DuiHStack() = default;
+
+DuiHStack& DuiHStack::nativeLayout(bool enable) & {
+    m_nativeLayout = enable;
+    return *this;
+}
+
+DuiHStack&& DuiHStack::nativeLayout(bool enable) && {
+    return std::move(nativeLayout(enable));
 }
 
-DuiHStack::DuiHStack(std::initializer_list<std::shared_ptr<DuiViewBase>> children) : DuiHStack() {
-    for (const auto& child : children) {
-        addChild(child);
+bool DuiHStack::updateFrom(DuiViewBase& next) {
+    auto& other = static_cast<DuiHStack&>(next);
+    bool relayout = other.m_nativeLayout != m_nativeLayout;
+    m_nativeLayout = other.m_nativeLayout;
+    if (relayout && m_lvObject) {
+        _lvSetLayout(m_lvObject, m_nativeLayout);
     }
+    return DuiContainer::updateFrom(next) || relayout;
+}
+
+lv_obj_t* DuiHStack::createObject(lv_obj_t* parent) {
+    return _lvCreateObject(parent, m_nativeLayout);
+}
+
+lv_obj_t* DuiHStack::_lvCreateObject(lv_obj_t* parent, bool nativeLayout) {
+    lv_obj_t* obj = lv_obj_create(parent);
+    lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+    _lvSetLayout(obj, nativeLayout);
+    return obj;
 }
 
-void DuiHStack::addChild(std::shared_ptr<DuiViewBase> child) {
-    m_children.push_back(child);
-    lv_obj_set_parent(child->lvObject(), m_lvObject);
+void DuiHStack::_lvSetLayout(lv_obj_t* obj, bool nativeLayout) {
+    if (nativeLayout) {
+        DuiStackLayout::apply(obj, DuiStackAxis::Horizontal);
+        return;
+    }
+    DuiStackLayout::remove(obj);
+    lv_obj_set_layout(obj, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(obj, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
 }
@@ -1,24 +1,40 @@
 #pragma once
 
-#include "core/DuiView.h"
+#include "core/DuiContainer.h"
 #include <vector>
 #include <memory>
+#include <type_traits>
 #include <utility> // For std::forward
 
-class DuiHStack : public DuiView<DuiHStack> {
+class DuiHStack : public DuiContainer<DuiHStack> {
 public:
+    static constexpr DuiSnapshotType SnapshotType = DuiSnapshotType::HStack;
+    static constexpr const char* TypeName = "DuiHStack";
+
     explicit DuiHStack();
-    DuiHStack(std::initializer_list<std::shared_ptr<DuiViewBase>> children);
     DuiHStack(DuiHStack&&) = default;
 
-    // 新增：可变参数模板构造函数
+    // Arrange the children with DuiStackLayout instead of flex; an update
+    // that toggles it switches the live object over
+    DuiHStack& nativeLayout(bool enable = true) &;
+    DuiHStack&& nativeLayout(bool enable = true) &&;
+
+    // 新增：可变参数模板构造函数，子视图移动进当前的 DuiArena（没有时分配在堆上）
     template<typename... Children>
+        requires (sizeof...(Children) > 0 && (std::is_base_of_v<DuiViewBase, std::remove_cvref_t<Children>> && ...))
     DuiHStack(Children&&... children) {
-        (addChild(std::make_shared<typename std::remove_reference<Children>::type>(std::move(children))), ...);
+        m_children.reserve(sizeof...(Children));
+        (addChild(DuiArena::makeNode(std::move(children))), ...);
     }
 
-    void addChild(std::shared_ptr<DuiViewBase> child);
+    // Flex or native stack container, shared with the static stack
+    static lv_obj_t* _lvCreateObject(lv_obj_t* parent, bool nativeLayout = false);
+    static void _lvSetLayout(lv_obj_t* obj, bool nativeLayout);
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override;
+    bool updateFrom(DuiViewBase& next) override;
 
 private:
-    std::vector<std::shared_ptr<DuiViewBase>> m_children;
+    bool m_nativeLayout = false;
 };
@@ -0,0 +1,252 @@
+#include "DuiLazyVStack.h"
+#include "lvgl.h"
+#include <algorithm>
+#include <utility>
+
+DuiLazyVStack::DuiLazyVStack(std::size_t itemCount, RowFactory factory, RowBinder binder)
+    : m_itemCount(itemCount), m_factory(std::move(factory)), m_binder(std::move(binder)) {}
+
+DuiLazyVStack::DuiLazyVStack(DuiLazyVStack&& other) noexcept
+    : DuiView(std::move(other)), m_itemCount(other.m_itemCount), m_factory(std::move(other.m_factory)),
+      m_binder(std::move(other.m_binder)), m_rowTypeOf(std::move(other.m_rowTypeOf)),
+      m_estimatedRowHeight(other.m_estimatedRowHeight), m_overscan(other.m_overscan),
+      m_heights(std::move(other.m_heights)), m_active(std::move(other.m_active)), m_window(std::move(other.m_window)),
+      m_pool(std::move(other.m_pool)), m_spacer(std::exchange(other.m_spacer, nullptr)),
+      m_inRelayout(other.m_inRelayout), m_relayoutPending(other.m_relayoutPending), m_stats(other.m_stats) {
+    if (!m_lvObject) {
+        return;
+    }
+    // The list and its rows carry the view's address as event user data
+    lv_obj_remove_event_cb_with_user_data(m_lvObject, scroll_event_cb, &other);
+    lv_obj_add_event_cb(m_lvObject, scroll_event_cb, LV_EVENT_SCROLL, this);
+    lv_obj_add_event_cb(m_lvObject, scroll_event_cb, LV_EVENT_SIZE_CHANGED, this);
+    auto retargetRow = [this, &other](DuiViewBase& row) {
+        DuiViewBase::attach(row, this);
+        lv_obj_remove_event_cb_with_user_data(row.lvObject(), row_size_event_cb, &other);
+        lv_obj_add_event_cb(row.lvObject(), row_size_event_cb, LV_EVENT_SIZE_CHANGED, this);
+    };
+    for (ActiveRow& row : m_active) {
+        retargetRow(*row.view);
+    }
+    for (auto& [type, rows] : m_pool) {
+        for (DuiNodePtr& row : rows) {
+            retargetRow(*row);
+        }
+    }
+}
+
+DuiLazyVStack& DuiLazyVStack::rowType(RowTypeOf rowTypeOf) & {
+    m_rowTypeOf = std::move(rowTypeOf);
+    return *this;
+}
+
+DuiLazyVStack&& DuiLazyVStack::rowType(RowTypeOf rowTypeOf) && {
+    return std::move(this->rowType(std::move(rowTypeOf)));
+}
+
+DuiLazyVStack& DuiLazyVStack::estimatedRowHeight(int32_t height) & {
+    m_estimatedRowHeight = height;
+    return *this;
+}
+
+DuiLazyVStack&& DuiLazyVStack::estimatedRowHeight(int32_t height) && {
+    return std::move(this->estimatedRowHeight(height));
+}
+
+DuiLazyVStack& DuiLazyVStack::overscan(int32_t pixels) & {
+    m_overscan = pixels;
+    return *this;
+}
+
+DuiLazyVStack&& DuiLazyVStack::overscan(int32_t pixels) && {
+    return std::move(this->overscan(pixels));
+}
+
+void DuiLazyVStack::setItemCount(std::size_t count) {
+    m_itemCount = count;
+    if (!m_lvObject) {
+        return;
+    }
+    m_heights.resize(count);
+    relayout();
+}
+
+std::size_t DuiLazyVStack::itemCount() const {
+    return m_itemCount;
+}
+
+void DuiLazyVStack::refreshRow(std::size_t index) {
+    for (ActiveRow& row : m_active) {
+        if (row.index == index) {
+            m_binder(*row.view, index);
+            ++m_stats.rowsBound;
+            return;
+        }
+    }
+}
+
+void DuiLazyVStack::scrollToRow(std::size_t index) {
+    if (m_lvObject && index < m_itemCount) {
+        lv_obj_scroll_to_y(m_lvObject, static_cast<int32_t>(m_heights.offsetOf(index)), LV_ANIM_OFF);
+    }
+}
+
+const DuiLazyStats& DuiLazyVStack::stats() const {
+    return m_stats;
+}
+
+lv_obj_t* DuiLazyVStack::createObject(lv_obj_t* parent) {
+    lv_obj_t* obj = lv_obj_create(parent);
+    lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+    lv_obj_add_event_cb(obj, scroll_event_cb, LV_EVENT_SCROLL, this);
+    lv_obj_add_event_cb(obj, scroll_event_cb, LV_EVENT_SIZE_CHANGED, this);
+    return obj;
+}
+
+void DuiLazyVStack::buildChildren() {
+    m_heights.reset(m_itemCount, m_estimatedRowHeight);
+
+    m_spacer = lv_obj_create(m_lvObject);
+    lv_obj_remove_style_all(m_spacer);
+    lv_obj_remove_flag(m_spacer, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(m_spacer, 1, 1);
+
+    relayout();
+}
+
+void DuiLazyVStack::relayout() {
+    if (!m_lvObject) {
+        return;
+    }
+    // Measurements arriving while the window is laid out restart the pass
+    if (m_inRelayout) {
+        m_relayoutPending = true;
+        return;
+    }
+    m_inRelayout = true;
+    do {
+        m_relayoutPending = false;
+        layoutWindow();
+    } while (m_relayoutPending);
+    m_inRelayout = false;
+}
+
+void DuiLazyVStack::layoutWindow() {
+    std::size_t first = 0;
+    std::size_t last = 0;
+    if (m_itemCount > 0) {
+        int32_t scrollY = lv_obj_get_scroll_y(m_lvObject);
+        int32_t viewHeight = lv_obj_get_content_height(m_lvObject);
+        int64_t top = std::max<int64_t>(0, static_cast<int64_t>(scrollY) - m_overscan);
+        int64_t bottom = static_cast<int64_t>(scrollY) + viewHeight + m_overscan;
+        first = m_heights.indexAt(top);
+        last = std::min(m_heights.indexAt(bottom) + 1, m_itemCount);
+    }
+
+    // Merge the sorted active rows with the new window: keep, release or acquire
+    m_window.reserve(last - first);
+    std::size_t k = 0;
+    for (std::size_t i = first; i < last; ++i) {
+        while (k < m_active.size() && m_active[k].index < i) {
+            release(m_active[k++]);
+        }
+        if (k < m_active.size() && m_active[k].index == i) {
+            m_window.push_back(std::move(m_active[k++]));
+        } else {
+            m_window.push_back(acquire(i));
+        }
+    }
+    while (k < m_active.size()) {
+        release(m_active[k++]);
+    }
+    // Both vectors keep their capacity, scrolling does not allocate
+    m_active.swap(m_window);
+    m_window.clear();
+
+    for (ActiveRow& row : m_active) {
+        auto y = static_cast<int32_t>(m_heights.offsetOf(row.index));
+        if (row.y != y) {
+            lv_obj_set_y(row.view->lvObject(), y);
+            row.y = y;
+        }
+    }
+    lv_obj_set_y(m_spacer, static_cast<int32_t>(std::max<int64_t>(0, m_heights.totalHeight() - 1)));
+
+    m_stats.rowsActive = m_active.size();
+}
+
+DuiLazyVStack::ActiveRow DuiLazyVStack::acquire(std::size_t index) {
+    uint32_t type = m_rowTypeOf ? m_rowTypeOf(index) : 0;
+    DuiNodePtr view;
+
+    auto& parked = m_pool[type];
+    if (!parked.empty()) {
+        view = std::move(parked.back());
+        parked.pop_back();
+        lv_obj_remove_flag(view->lvObject(), LV_OBJ_FLAG_HIDDEN);
+        --m_stats.rowsPooled;
+        ++m_stats.rowsRecycled;
+    } else {
+        view = m_factory(type);
+        DuiViewBase::attach(*view, this);
+        view->_build(m_lvObject);
+        lv_obj_add_event_cb(view->lvObject(), row_size_event_cb, LV_EVENT_SIZE_CHANGED, this);
+        ++m_stats.rowsCreated;
+    }
+
+    m_binder(*view, index);
+    ++m_stats.rowsBound;
+    return ActiveRow{index, type, -1, std::move(view)};
+}
+
+void DuiLazyVStack::release(ActiveRow& row) {
+    lv_obj_add_flag(row.view->lvObject(), LV_OBJ_FLAG_HIDDEN);
+    m_pool[row.type].push_back(std::move(row.view));
+    ++m_stats.rowsPooled;
+}
+
+void DuiLazyVStack::onRowSizeChanged(lv_obj_t* obj) {
+    for (const ActiveRow& row : m_active) {
+        if (row.view && row.view->lvObject() == obj) {
+            int32_t height = lv_obj_get_height(obj);
+            if (height > 0 && height != m_heights.heightOf(row.index)) {
+                m_heights.setHeight(row.index, height);
+                relayout();
+            }
+            return;
+        }
+    }
+}
+
+void DuiLazyVStack::scroll_event_cb(lv_event_t* e) {
+    auto* self = static_cast<DuiLazyVStack*>(lv_event_get_user_data(e));
+    self->relayout();
+}
+
+void DuiLazyVStack::row_size_event_cb(lv_event_t* e) {
+    auto* self = static_cast<DuiLazyVStack*>(lv_event_get_user_data(e));
+    self->onRowSizeChanged(static_cast<lv_obj_t*>(lv_event_get_target(e)));
+}
+
+void DuiLazyVStack::accountMemory(DuiMemoryWalker& walker) const {
+    DuiView::accountMemory(walker);
+    for (const ActiveRow& row : m_active) {
+        walker.addChild(*row.view);
+    }
+    for (const auto& [type, rows] : m_pool) {
+        for (const DuiNodePtr& row : rows) {
+            walker.addChild(*row);
+        }
+    }
+}
+
+std::size_t DuiLazyVStack::heapBytes() const {
+    std::size_t bytes = DuiView::heapBytes() + m_heights.heapBytes() +
+                        (m_active.capacity() + m_window.capacity()) * sizeof(ActiveRow);
+    for (const auto& [type, rows] : m_pool) {
+        // Node of the map plus the row pointers
+        bytes += sizeof(std::pair<const uint32_t, std::vector<DuiNodePtr>>) + 2 * sizeof(void*) +
+                 rows.capacity() * sizeof(DuiNodePtr);
+    }
+    return bytes;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "core/DuiView.h"
+#include "core/DuiArena.h"
+#include "core/DuiHeightIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Counters of a lazy stack, to size the overscan and the reuse pool
+struct DuiLazyStats {
+    std::size_t rowsCreated = 0;  // Row views built by the factory
+    std::size_t rowsRecycled = 0; // Rows taken from the reuse pool
+    std::size_t rowsBound = 0;    // Binder calls
+    std::size_t rowsActive = 0;
+    std::size_t rowsPooled = 0;
+};
+
+// Virtualized vertical list
+//
+// Only the rows inside the viewport plus an overscan margin exist. Rows that
+// scroll out are hidden and parked in a pool keyed by row type, and rows that
+// scroll in take a parked row of their type and rebind it. Row heights start
+// at an estimate and are replaced by the measured height once LVGL has laid a
+// row out, so variable heights are supported.
+//
+// Rows are positioned absolutely, give them a content or fixed height
+// (stacks default to 100% of the parent).
+class DuiLazyVStack : public DuiView<DuiLazyVStack> {
+public:
+    using RowFactory = std::function<DuiNodePtr(uint32_t rowType)>;
+    using RowBinder = std::function<void(DuiViewBase& row, std::size_t index)>;
+    using RowTypeOf = std::function<uint32_t(std::size_t index)>;
+    static constexpr const char* TypeName = "DuiLazyVStack";
+
+    DuiLazyVStack(std::size_t itemCount, RowFactory factory, RowBinder binder);
+    DuiLazyVStack(DuiLazyVStack&& other) noexcept;
+
+    // ==================== Modifiers ====================
+    DuiLazyVStack& rowType(RowTypeOf rowTypeOf) &;
+    DuiLazyVStack&& rowType(RowTypeOf rowTypeOf) &&;
+
+    DuiLazyVStack& estimatedRowHeight(int32_t height) &;
+    DuiLazyVStack&& estimatedRowHeight(int32_t height) &&;
+
+    // Extra pixels materialized above and below the viewport
+    DuiLazyVStack& overscan(int32_t pixels) &;
+    DuiLazyVStack&& overscan(int32_t pixels) &&;
+
+    // ==================== Data ====================
+    void setItemCount(std::size_t count);
+    std::size_t itemCount() const;
+    // Rebind a visible row after its data changed
+    void refreshRow(std::size_t index);
+    void scrollToRow(std::size_t index);
+
+    const DuiLazyStats& stats() const;
+
+    // Visible and pooled rows are children in memory reports
+    void accountMemory(DuiMemoryWalker& walker) const override;
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override;
+    void buildChildren() override;
+    std::size_t heapBytes() const override;
+
+private:
+    struct ActiveRow {
+        std::size_t index;
+        uint32_t type;
+        int32_t y;
+        DuiNodePtr view;
+    };
+
+    void relayout();
+    void layoutWindow();
+    ActiveRow acquire(std::size_t index);
+    void release(ActiveRow& row);
+    void onRowSizeChanged(lv_obj_t* obj);
+
+    static void scroll_event_cb(lv_event_t* e);
+    static void row_size_event_cb(lv_event_t* e);
+
+    std::size_t m_itemCount;
+    RowFactory m_factory;
+    RowBinder m_binder;
+    RowTypeOf m_rowTypeOf;
+    int32_t m_estimatedRowHeight = 40;
+    int32_t m_overscan = 200;
+
+    DuiHeightIndex m_heights;
+    std::vector<ActiveRow> m_active; // Sorted by index
+    std::vector<ActiveRow> m_window; // Scratch of layoutWindow, swapped with m_active
+    std::unordered_map<uint32_t, std::vector<DuiNodePtr>> m_pool;
+    lv_obj_t* m_spacer = nullptr;    // Stretches the scrollable content to the full list height
+    bool m_inRelayout = false;
+    bool m_relayoutPending = false;
+    DuiLazyStats m_stats;
+};
@@ -0,0 +1,156 @@
+#include "DuiStackLayout.h"
+#include <algorithm>
+#include <vector>
+
+uint32_t DuiStackLayout::s_layoutId = 0;
+DuiStackLayoutStats DuiStackLayout::s_stats;
+
+namespace {
+
+// A child as last arranged
+struct Slot {
+    lv_obj_t* obj;
+    int32_t width;
+    int32_t height;
+    int32_t x;    // Position last written, relative to the content box
+    int32_t y;
+    int32_t next; // Main axis offset of the following child
+    bool skipped; // Hidden or out of the layout
+    bool placed;  // Moved into place since it joined the stack
+};
+
+// Owned by the stack's LVGL object, found through its delete callback
+struct State {
+    DuiStackAxis axis = DuiStackAxis::Vertical;
+    int32_t contentWidth = -1;
+    int32_t contentHeight = -1;
+    int32_t padLeft = 0;
+    int32_t padTop = 0;
+    int32_t gap = 0;
+    std::vector<Slot> slots;
+};
+
+constexpr lv_obj_flag_t NotLaidOut =
+    static_cast<lv_obj_flag_t>(LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_FLOATING);
+
+} // namespace
+
+void DuiStackLayout::apply(lv_obj_t* obj, DuiStackAxis axis) {
+    if (!s_layoutId) {
+        s_layoutId = lv_layout_register(update, nullptr);
+    }
+    State* state = new State();
+    state->axis = axis;
+    lv_obj_add_event_cb(obj, deleteCb, LV_EVENT_DELETE, state);
+    lv_obj_set_layout(obj, s_layoutId);
+}
+
+void DuiStackLayout::remove(lv_obj_t* obj) {
+    if (State* state = static_cast<State*>(stateOf(obj))) {
+        lv_obj_remove_event_cb_with_user_data(obj, deleteCb, state);
+        delete state;
+    }
+}
+
+// A stack has at most a delete and a click callback, the scan is short
+void* DuiStackLayout::stateOf(lv_obj_t* obj) {
+    for (uint32_t i = 0, count = lv_obj_get_event_count(obj); i < count; ++i) {
+        lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+        if (lv_event_dsc_get_cb(dsc) == deleteCb) {
+            return lv_event_dsc_get_user_data(dsc);
+        }
+    }
+    return nullptr;
+}
+
+void DuiStackLayout::update(lv_obj_t* obj, void* userData) {
+    (void)userData;
+    State* state = static_cast<State*>(stateOf(obj));
+    if (!state) {
+        return;
+    }
+    ++s_stats.passes;
+
+    bool vertical = state->axis == DuiStackAxis::Vertical;
+    int32_t contentWidth = lv_obj_get_content_width(obj);
+    int32_t contentHeight = lv_obj_get_content_height(obj);
+    int32_t padLeft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
+    int32_t padTop = lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
+    int32_t gap = vertical ? lv_obj_get_style_pad_row(obj, LV_PART_MAIN) : lv_obj_get_style_pad_column(obj, LV_PART_MAIN);
+    bool boxChanged = contentWidth != state->contentWidth || contentHeight != state->contentHeight ||
+                      padLeft != state->padLeft || padTop != state->padTop || gap != state->gap;
+    state->contentWidth = contentWidth;
+    state->contentHeight = contentHeight;
+    state->padLeft = padLeft;
+    state->padTop = padTop;
+    state->gap = gap;
+
+    // Measure: the sizes LVGL refreshed before calling the layout, against the cache
+    std::vector<Slot>& slots = state->slots;
+    uint32_t count = lv_obj_get_child_count(obj);
+    std::size_t first = boxChanged ? 0 : count;
+    if (slots.size() != count) {
+        first = std::min<std::size_t>(first, std::min<std::size_t>(slots.size(), count));
+        slots.resize(count);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        lv_obj_t* child = lv_obj_get_child(obj, i);
+        int32_t width = lv_obj_get_width(child);
+        int32_t height = lv_obj_get_height(child);
+        bool skipped = lv_obj_has_flag_any(child, NotLaidOut);
+        Slot& slot = slots[i];
+        if (slot.obj != child) {
+            slot = {child, width, height, 0, 0, 0, skipped, false};
+            first = std::min<std::size_t>(first, i);
+        } else if (slot.width != width || slot.height != height || slot.skipped != skipped) {
+            slot.width = width;
+            slot.height = height;
+            slot.skipped = skipped;
+            first = std::min<std::size_t>(first, i);
+        }
+    }
+    if (first == count) {
+        ++s_stats.skipped;
+        return;
+    }
+
+    // Arrange: the children before the first change keep their place
+    int32_t offset = first ? slots[first - 1].next : 0;
+    for (std::size_t i = first; i < count; ++i) {
+        Slot& slot = slots[i];
+        if (!slot.skipped) {
+            int32_t x = vertical ? (contentWidth - slot.width) / 2 : offset;
+            int32_t y = vertical ? offset : (contentHeight - slot.height) / 2;
+            // Scrolling and moving the stack carry the children along, an
+            // unchanged relative position needs no write
+            if (!slot.placed || x != slot.x || y != slot.y) {
+                lv_obj_move_to(slot.obj, padLeft + x, padTop + y);
+                slot.x = x;
+                slot.y = y;
+                slot.placed = true;
+                ++s_stats.moves;
+            }
+            offset += (vertical ? slot.height : slot.width) + gap;
+            ++s_stats.arranged;
+        }
+        slot.next = offset;
+    }
+
+    // A content sized stack takes its size from the children just placed
+    if (lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT ||
+        lv_obj_get_style_height(obj, LV_PART_MAIN) == LV_SIZE_CONTENT) {
+        lv_obj_refr_size(obj);
+    }
+}
+
+void DuiStackLayout::deleteCb(lv_event_t* e) {
+    delete static_cast<State*>(lv_event_get_user_data(e));
+}
+
+const DuiStackLayoutStats& DuiStackLayout::stats() {
+    return s_stats;
+}
+
+void DuiStackLayout::resetStats() {
+    s_stats = DuiStackLayoutStats{};
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstdint>
+
+enum class DuiStackAxis : uint8_t {
+    Vertical,
+    Horizontal,
+};
+
+// Counters to compare the native stack layout with flex
+struct DuiStackLayoutStats {
+    uint64_t passes = 0;   // Layout callbacks of native stacks
+    uint64_t skipped = 0;  // Passes that found no child or box change
+    uint64_t arranged = 0; // Children whose position was recomputed
+    uint64_t moves = 0;    // lv_obj_move_to calls, children that actually moved
+};
+
+// Native measure/arrange pass for DuiVStack and DuiHStack, opted into with
+// .nativeLayout()
+//
+// Flex recomputes every track and looks up the flex styles of every child
+// whenever the container is marked dirty. A native stack only lines its
+// children up: start of the main axis, centered on the cross axis, the gap
+// being pad_row (vertical) or pad_column (horizontal); margins, grow and
+// wrapping are not supported. Each stack caches the size and position of
+// every child from its last pass. A pass compares the children's sizes,
+// which LVGL has already refreshed, with the cache and arranges only from
+// the first child that was added, removed, hidden or resized; the children
+// before it keep their positions and a pass that finds no change returns
+// right away. A child whose position changed is placed with one
+// lv_obj_move_to, which touches no style. A stack with a fixed or percentage
+// size does not depend on its children, so a change inside it does not dirty
+// any of its ancestors. A stack sized LV_SIZE_CONTENT refreshes its size
+// after arranging, as flex does; when that size changes its parent is laid
+// out again and the next pass re-arranges the stack from its first child.
+class DuiStackLayout {
+public:
+    // Lay out the children of obj with the native pass from now on
+    static void apply(lv_obj_t* obj, DuiStackAxis axis);
+    // Stop laying out obj, the caller sets the next layout; a no-op for other objects
+    static void remove(lv_obj_t* obj);
+
+    static const DuiStackLayoutStats& stats();
+    static void resetStats();
+
+private:
+    static void* stateOf(lv_obj_t* obj);
+    static void update(lv_obj_t* obj, void* userData);
+    static void deleteCb(lv_event_t* e);
+
+    static uint32_t s_layoutId;
+    static DuiStackLayoutStats s_stats;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "core/DuiStaticContainer.h"
+#include "layouts/DuiVStack.h"
+#include "layouts/DuiHStack.h"
+#include <type_traits>
+#include <utility>
+
+// Compile-time composed stacks, the whole tree lives inside the root object.
+// DuiVStack/DuiHStack remain for runtime-sized content.
+template<typename... Children>
+class DuiStaticVStack : public DuiStaticContainer<DuiStaticVStack<Children...>, Children...> {
+public:
+    static constexpr DuiSnapshotType SnapshotType = DuiSnapshotType::VStack;
+    static constexpr const char* TypeName = "DuiStaticVStack";
+
+    using DuiStaticContainer<DuiStaticVStack<Children...>, Children...>::DuiStaticContainer;
+
+    // Arrange the children with DuiStackLayout instead of flex, see DuiVStack
+    DuiStaticVStack& nativeLayout(bool enable = true) & {
+        m_nativeLayout = enable;
+        return *this;
+    }
+    DuiStaticVStack&& nativeLayout(bool enable = true) && {
+        return std::move(nativeLayout(enable));
+    }
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override {
+        return DuiVStack::_lvCreateObject(parent, m_nativeLayout);
+    }
+
+    bool updateFrom(DuiViewBase& next) override {
+        auto& other = static_cast<DuiStaticVStack&>(next);
+        bool relayout = other.m_nativeLayout != m_nativeLayout;
+        m_nativeLayout = other.m_nativeLayout;
+        if (relayout && this->m_lvObject) {
+            DuiVStack::_lvSetLayout(this->m_lvObject, m_nativeLayout);
+        }
+        return DuiStaticContainer<DuiStaticVStack<Children...>, Children...>::updateFrom(next) || relayout;
+    }
+
+private:
+    bool m_nativeLayout = false;
+};
+
+template<typename... Children>
+DuiStaticVStack(Children&&...) -> DuiStaticVStack<std::remove_cvref_t<Children>...>;
+
+template<typename... Children>
+class DuiStaticHStack : public DuiStaticContainer<DuiStaticHStack<Children...>, Children...> {
+public:
+    static constexpr DuiSnapshotType SnapshotType = DuiSnapshotType::HStack;
+    static constexpr const char* TypeName = "DuiStaticHStack";
+
+    using DuiStaticContainer<DuiStaticHStack<Children...>, Children...>::DuiStaticContainer;
+
+    // Arrange the children with DuiStackLayout instead of flex, see DuiHStack
+    DuiStaticHStack& nativeLayout(bool enable = true) & {
+        m_nativeLayout = enable;
+        return *this;
+    }
+    DuiStaticHStack&& nativeLayout(bool enable = true) && {
+        return std::move(nativeLayout(enable));
+    }
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override {
+        return DuiHStack::_lvCreateObject(parent, m_nativeLayout);
+    }
+
+    bool updateFrom(DuiViewBase& next) override {
+        auto& other = static_cast<DuiStaticHStack&>(next);
+        bool relayout = other.m_nativeLayout != m_nativeLayout;
+        m_nativeLayout = other.m_nativeLayout;
+        if (relayout && this->m_lvObject) {
+            DuiHStack::_lvSetLayout(this->m_lvObject, m_nativeLayout);
+        }
+        return DuiStaticContainer<DuiStaticHStack<Children...>, Children...>::updateFrom(next) || relayout;
+    }
+
+private:
+    bool m_nativeLayout = false;
+};
+
+template<typename... Children>
+DuiStaticHStack(Children&&...) -> DuiStaticHStack<std::remove_cvref_t<Children>...>;
@@ -1,29 +1,76 @@
 #include "DuiVStack.h"
+#include "DuiStackLayout.h"
 #include "lvgl.h"
 
-DuiVStack::DuiVStack() {
-    m_lvObject = lv_obj_create(lv_scr_act());
-    lv_obj_set_size(m_lvObject, LV_PCT(100), LV_PCT(100));
-    lv_obj_set_layout(m_lvObject, LV_LAYOUT_FLEX);
-    lv_obj_set_flex_flow(m_lvObject, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(m_lvObject, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+DuiVStack::DuiVStack() = default;
+
+DuiVStack::DuiVStack(ContentBuilder builder) : DuiVStack() {
+    m_builder = std::move(builder);
+    DuiChildList children;
+    m_builder(children);
+    m_children.reserve(children.nodes().size());
+    for (auto& child : children.nodes()) {
+        addChild(std::move(child));
+    }
 }
 
-DuiVStack::DuiVStack(std::initializer_list<std::shared_ptr<DuiViewBase>> children) : DuiVStack() {
-    for (const auto& child : children) {
-        addChild(child);
+DuiReconcileStats DuiVStack::update() {
+    if (!m_builder) {
+        return {};
     }
+
+    // The description is thrown away after the diff, keep it out of the screen arena
+    DuiArenaScope heapScope(nullptr);
+    DuiChildList children;
+    m_builder(children);
+    return reconcileChildren(children.nodes());
 }
 
-DuiVStack::DuiVStack(ContentBuilder builder) : DuiVStack() {
-    auto adder = [this](std::shared_ptr<DuiViewBase> child) {
-        this->addChild(child);
-    };
-    builder(adder);
+DuiReconcileStats DuiVStack::update(ContentBuilder builder) {
+    m_builder = std::move(builder);
+    return update();
 }
 
+DuiVStack& DuiVStack::nativeLayout(bool enable) & {
+    m_nativeLayout = enable;
+    return *this;
+}
+
+DuiVStack&& DuiVStack::nativeLayout(bool enable) && {
+    return std::move(nativeLayout(enable));
+}
 
-void DuiVStack::addChild(std::shared_ptr<DuiViewBase> child) {
-    m_children.push_back(child);
-    lv_obj_set_parent(child->lvObject(), m_lvObject);
+bool DuiVStack::updateFrom(DuiViewBase& next) {
+    auto& other = static_cast<DuiVStack&>(next);
+    if (other.m_builder) {
+        m_builder = std::move(other.m_builder);
+    }
+    bool relayout = other.m_nativeLayout != m_nativeLayout;
+    m_nativeLayout = other.m_nativeLayout;
+    if (relayout && m_lvObject) {
+        _lvSetLayout(m_lvObject, m_nativeLayout);
+    }
+    return DuiContainer::updateFrom(next) || relayout;
+}
+
+lv_obj_t* DuiVStack::createObject(lv_obj_t* parent) {
+    return _lvCreateObject(parent, m_nativeLayout);
+}
+
+lv_obj_t* DuiVStack::_lvCreateObject(lv_obj_t* parent, bool nativeLayout) {
+    lv_obj_t* obj = lv_obj_create(parent);
+    lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+    _lvSetLayout(obj, nativeLayout);
+    return obj;
+}
+
+void DuiVStack::_lvSetLayout(lv_obj_t* obj, bool nativeLayout) {
+    if (nativeLayout) {
+        DuiStackLayout::apply(obj, DuiStackAxis::Vertical);
+        return;
+    }
+    DuiStackLayout::remove(obj);
+    lv_obj_set_layout(obj, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(obj, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
 }
@@ -1,28 +1,48 @@
 #pragma once
 
-#include "core/DuiView.h"
+#include "core/DuiContainer.h"
 #include <vector>
 #include <memory>
 #include <functional>
+#include <type_traits>
 #include <utility>
 
-class DuiVStack : public DuiView<DuiVStack> {
+class DuiVStack : public DuiContainer<DuiVStack> {
 public:
-    using ContentBuilder = std::function<void(std::function<void(std::shared_ptr<DuiViewBase>)>)>;
+    using ContentBuilder = std::function<void(DuiChildList&)>;
+    static constexpr DuiSnapshotType SnapshotType = DuiSnapshotType::VStack;
+    static constexpr const char* TypeName = "DuiVStack";
 
     explicit DuiVStack();
-    DuiVStack(std::initializer_list<std::shared_ptr<DuiViewBase>> children);
     DuiVStack(ContentBuilder builder);
     DuiVStack(DuiVStack&&) = default;
 
-    // 可变参数模板构造函数
+    // Re-run the content builder and reconcile the result with the live children
+    DuiReconcileStats update();
+    DuiReconcileStats update(ContentBuilder builder);
+
+    // Arrange the children with DuiStackLayout instead of flex; an update
+    // that toggles it switches the live object over
+    DuiVStack& nativeLayout(bool enable = true) &;
+    DuiVStack&& nativeLayout(bool enable = true) &&;
+
+    // 可变参数模板构造函数，子视图移动进当前的 DuiArena（没有时分配在堆上）
     template<typename... Children>
+        requires (sizeof...(Children) > 0 && (std::is_base_of_v<DuiViewBase, std::remove_cvref_t<Children>> && ...))
     DuiVStack(Children&&... children) {
-        (addChild(std::make_shared<typename std::remove_reference<Children>::type>(std::move(children))), ...);
+        m_children.reserve(sizeof...(Children));
+        (addChild(DuiArena::makeNode(std::move(children))), ...);
     }
 
-    void addChild(std::shared_ptr<DuiViewBase> child);
+    // Flex or native stack container, shared with the static stack
+    static lv_obj_t* _lvCreateObject(lv_obj_t* parent, bool nativeLayout = false);
+    static void _lvSetLayout(lv_obj_t* obj, bool nativeLayout);
+
+protected:
+    lv_obj_t* createObject(lv_obj_t* parent) override;
+    bool updateFrom(DuiViewBase& next) override;
 
 private:
-    std::vector<std::shared_ptr<DuiViewBase>> m_children;
+    ContentBuilder m_builder;
+    bool m_nativeLayout = false;
 };
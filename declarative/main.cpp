@@ -4,14 +4,41 @@
 #include "layouts/DuiHStack.h"
 #include "components/DuiText.h"
 #include "components/DuiButton.h"
+#include "layouts/DuiStaticStack.h"
+#include "core/DuiState.h"
+#include "core/DuiMutationQueue.h"
+#include "core/DuiTask.h"
+#include "core/DuiSnapshot.h"
+#include "core/DuiMemory.h"
+#include "LVGLApplication.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <string>
 #include <iostream>
+#include <thread>
 
 // 为了使用新语法，我们需要为 DuiText 和 DuiButton 添加移动构造函数
 // (通常编译器会自动生成，但显式声明一下更清晰)
 
+// 后台线程更新的文本 (--worker)
+static DuiText* workerText = nullptr;
+
+// 协程写的交互流程：点击后显示确认文字，一秒后恢复，循环直到按钮被销毁
+static DuiTask rightButtonFlow(DuiButton& button) {
+    while (co_await button.clicked()) {
+        button.setLabel("Done!");
+        co_await DuiTask::delay(1000);
+        button.setLabel("Right");
+    }
+}
+
 // A simple example of how to use the declarative UI
-void dui_main() {
+// 根视图交给 root，状态由调用方持有，二者都要在 LVGL 反初始化之前释放；
+// 返回示例按钮的 lv_obj_t，无头模式用它注入点击
+lv_obj_t* dui_main(DuiNodePtr& root, DuiState<int32_t>& clickCount) {
     // 之前使用尾随 Lambda 的代码
     /*
     auto* ui_root = new DuiVStack(nullptr, [](auto&amp; add) {
@@ -32,37 +59,193 @@ void dui_main() {
     */
 
     // ⭐ 使用最终的、基于可变参数模板和移动语义的语法 ⭐
-    new DuiVStack(
+    // 构造阶段只记录描述，_build() 一次性在最终父对象下创建全部 lv_obj_t
+    // 结构在编译期已知，使用静态栈：子视图按值保存在 std::tuple 中，C++ 侧不做逐个子视图的堆分配
+    auto* example = new DuiStaticVStack(
         DuiText("This is the ultimate syntax!").width(200),
         DuiButton("Movable Button")
+            .key("movable")
             .bgColor(lv_palette_main(LV_PALETTE_BLUE))
-            .onClick([]{ std::cout << "Moved button clicked!" << std::endl; }),
-        DuiHStack(
+            .onClick([&clickCount]{
+                std::cout << "Moved button clicked!" << std::endl;
+                clickCount = clickCount.get() + 1;
+            }),
+        DuiText("").text(clickCount, "Clicked %d times"),
+        DuiStaticHStack(
             DuiText("Left"),
             DuiButton("Right")
         )
     );
+    root = DuiNodePtr(example);
+    // 根容器用一个处理函数分发所有按钮的点击
+    example->delegateEvents();
+    example->_build(lv_scr_act());
+    workerText = &example->child<0>();
+    // 任务归根视图所有，根视图销毁时一并取消
+    DuiTask::spawn(*example, rightButtonFlow(example->child<3>().child<1>()));
+    return example->child<1>().lvObject();
 }
 
-// NOTE: This is a placeholder main function.
-// In a real project, you would integrate this with your application's main loop
-// and lvgl's tick/handler functions.
-int main(int argc, char** argv) {
-    // Basic LVGL initialization
-    lv_init();
+// 命令行选项，见 main
+struct ExampleOptions {
+    uint32_t headlessFrames = 0;
+    const char* writeSnapshot = nullptr;
+    const char* snapshotFile = nullptr;
+    const char* layoutFile = nullptr;
+    bool worker = false;
+    bool memory = false;
+};
+
+// 视图、状态和快照都是这里的局部变量，返回时按声明的逆序释放，
+// 此时 LVGL 仍然可用；main 在之后才调用 app.cleanup()
+static int runExample(LVGLApplication& app, const ExampleOptions& options) {
+    // 布局文件中的回调名对应的处理函数，要比视图活得更久
+    int32_t layoutClicks = 0;
+    DuiSnapshotHandlers handlers = {
+        {"greet", [](DuiViewBase&) { std::cout << "Hello from a layout file!" << std::endl; }},
+        {"count", [&layoutClicks](DuiViewBase& view) {
+            static_cast<DuiButton&>(view).setLabel("Count: " + std::to_string(++layoutClicks));
+        }},
+    };
+    // 状态要比绑定它的文本活得更久，所以它在视图之前声明
+    DuiState<int32_t> clickCount(0);
+    DuiNodePtr exampleRoot;
+
+    if (options.writeSnapshot) {
+        dui_main(exampleRoot, clickCount);
+        if (!DuiSnapshot::save(*exampleRoot, options.writeSnapshot)) {
+            std::cerr << "Failed to write snapshot " << options.writeSnapshot << std::endl;
+            return -1;
+        }
+        return 0;
+    }
 
-    // Initialize display and input devices (platform-specific)
-    // For PC simulator, this is usually handled by lv_port_pc_eclipse's main.c
-    // We are just calling our dui_main here to construct the UI.
-    // In a real application, you would need to replace the default main loop.
+    // 快照要在界面存在期间一直映射着：标签文字直接指向文件内容，所以它在视图之前声明
+    std::unique_ptr<DuiSnapshot> snapshot;
+    DuiNodePtr layoutRoot;
+    lv_obj_t* button = nullptr;
+    const char* snapshotPath = options.snapshotFile ? options.snapshotFile : options.layoutFile;
+    auto buildStart = std::chrono::steady_clock::now();
+    if (snapshotPath) {
+        snapshot = DuiSnapshot::load(snapshotPath);
+        if (!snapshot) {
+            std::cerr << "Failed to load snapshot " << snapshotPath << std::endl;
+            return -1;
+        }
+    }
+    if (options.snapshotFile) {
+        snapshot->instantiate(lv_scr_act());
+        button = snapshot->find("movable");
+    } else if (options.layoutFile) {
+        layoutRoot = snapshot->build(handlers);
+        if (layoutRoot) {
+            layoutRoot->_build(lv_scr_act());
+        }
+    } else {
+        button = dui_main(exampleRoot, clickCount);
+    }
+    std::chrono::duration<double, std::micro> buildTime = std::chrono::steady_clock::now() - buildStart;
+    std::cout << (options.snapshotFile ? "Snapshot" : options.layoutFile ? "Layout" : "Constructors") << " build: "
+              << buildTime.count() << " us" << std::endl;
+    // 快照直接创建的对象没有视图，无从统计
+    DuiViewBase* memoryRoot = options.layoutFile ? layoutRoot.get() : exampleRoot.get();
+    if (options.memory && memoryRoot) {
+        DuiMemory::print(DuiMemory::measure(*memoryRoot), std::cout);
+    }
 
-    dui_main();
+    if (!options.headlessFrames) {
+        std::atomic<bool> stop(false);
+        std::thread sensor;
+        if (options.worker && workerText) {
+            // 每 10 ms 一个读数，比刷新周期快：两帧之间的多次写入只保留最后一次
+            sensor = std::thread([&stop] {
+                for (int reading = 0; !stop; ++reading) {
+                    workerText->postText("Sensor: " + std::to_string(reading));
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            });
+        }
+        app.run();
+        stop = true;
+        if (sensor.joinable()) {
+            sensor.join();
+        }
+        DuiMutationStats stats = DuiMutationQueue::stats();
+        if (stats.posted) {
+            std::cout << "Mutations: posted " << stats.posted << ", executed " << stats.executed << ", coalesced "
+                      << stats.coalesced << ", wakeups " << stats.wakeups << std::endl;
+        }
+        return 0;
+    }
 
-    // LVGL's task handler loop
-    // while(1) {
-    //     lv_timer_handler();
-    //     usleep(5 * 1000);
-    // }
+    // 通过虚拟指针点击按钮，验证输入注入
+    app.renderFrame();
+    if (button) {
+        lv_area_t area;
+        lv_obj_get_coords(button, &area);
+        app.injectClick((area.x1 + area.x2) / 2, (area.y1 + area.y2) / 2);
+    }
 
+    app.resetFrameStats();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < options.headlessFrames; ++i) {
+        lv_obj_invalidate(lv_screen_active());
+        app.renderFrame();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    app.printFrameStats(elapsed.count());
     return 0;
 }
+
+// --headless N 在内存中渲染 N 帧并打印帧统计，不需要窗口系统；
+// 否则打开 SDL 窗口进入主循环。--frame-report FILE 在退出时写出帧耗时分位数 (JSON)。
+// --worker 启动一个模拟传感器的后台线程，通过 DuiMutationQueue 更新第一行文本
+// --write-snapshot FILE 把示例界面写成快照文件后退出 (构建时调用)；
+// --snapshot FILE 从快照创建界面，不执行视图构造，只有静态结构，没有回调；
+// --layout FILE 从 dui_layoutc 编译的布局文件创建 Dui 视图树，按名字绑定下面的处理函数；
+// --memory 构建后打印视图树按类型统计的 C++ 与 LVGL 内存
+int main(int argc, char** argv) {
+    ExampleOptions options;
+    const char* frameReport = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+            options.headlessFrames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--frame-report") == 0 && i + 1 < argc) {
+            frameReport = argv[++i];
+        } else if (std::strcmp(argv[i], "--worker") == 0) {
+            options.worker = true;
+        } else if (std::strcmp(argv[i], "--write-snapshot") == 0 && i + 1 < argc) {
+            options.writeSnapshot = argv[++i];
+        } else if (std::strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            options.snapshotFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--layout") == 0 && i + 1 < argc) {
+            options.layoutFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--memory") == 0) {
+            options.memory = true;
+        }
+    }
+
+    LVGLApplication app;
+    HeadlessConfig headless;
+    headless.width = 480;
+    headless.height = 320;
+    bool offscreen = options.headlessFrames || options.writeSnapshot;
+    bool initialized = offscreen ? app.initializeHeadless(headless) : app.initialize(480, 320);
+    if (!initialized) {
+        std::cerr << "Failed to initialize LVGL application" << std::endl;
+        return -1;
+    }
+    if (frameReport) {
+        app.setFrameReport(frameReport);
+    }
+
+    // 后台线程投递的修改在每帧开始时执行，投递时唤醒主循环立即刷新
+    DuiMutationQueue::attach(app.getDisplay());
+    DuiMutationQueue::setWakeup([](void* context) { static_cast<LVGLApplication*>(context)->requestFrame(); }, &app);
+
+    // runExample 返回时界面已经释放，之后才反初始化 LVGL
+    int result = runExample(app, options);
+    DuiMutationQueue::setWakeup(nullptr, nullptr);
+    app.cleanup();
+    return result;
+}
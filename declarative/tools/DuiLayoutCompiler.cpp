@@ -0,0 +1,273 @@
+/**
+ * @file DuiLayoutCompiler.cpp
+ * @brief dui_layoutc: converts a text layout into the binary DuiSnapshot format
+ *
+ * Usage: dui_layoutc input.dui output.snap
+ *
+ * One view per line, children indented deeper than their parent (spaces
+ * only, a tab in the indentation is an error), '#' starts a comment line:
+ *
+ *   vstack key=main
+ *     text "Sensor dashboard" width=200
+ *     button "Refresh" bg=#2196F3 onClick=refresh
+ *     hstack
+ *       text "Left"
+ *       image "A:icons/wifi.png" width=32 height=32
+ *
+ * Views: vstack, hstack, text "label", button "label", image "path".
+ * Attributes: key=name, width=px, height=px (0 to LV_COORD_MAX),
+ * bg=#RRGGBB (buttons), onClick=handler (buttons). Values may be quoted;
+ * handler names are bound to C++ handlers by DuiSnapshot::build(). Errors
+ * are reported as file:line: message and leave no output file.
+ */
+
+#include "core/DuiSnapshot.h"
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct Line {
+    std::size_t indent = 0;
+    std::string type;
+    std::optional<std::string> text;
+    std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+struct Open {
+    std::size_t indent;
+    uint32_t node;
+    DuiSnapshotType type;
+};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// A bare word up to the next space or '=', or a quoted string with \" and \\ escapes
+bool readToken(std::string_view& rest, std::string& out, std::string& error) {
+    out.clear();
+    if (rest.empty() || rest.front() != '"') {
+        std::size_t end = 0;
+        while (end < rest.size() && !isSpace(rest[end]) && rest[end] != '=') {
+            ++end;
+        }
+        out.assign(rest.substr(0, end));
+        rest.remove_prefix(end);
+        return true;
+    }
+    for (std::size_t i = 1; i < rest.size(); ++i) {
+        if (rest[i] == '\\' && i + 1 < rest.size()) {
+            out.push_back(rest[++i]);
+        } else if (rest[i] == '"') {
+            rest.remove_prefix(i + 1);
+            return true;
+        } else {
+            out.push_back(rest[i]);
+        }
+    }
+    error = "unterminated string";
+    return false;
+}
+
+void skipSpaces(std::string_view& rest) {
+    while (!rest.empty() && isSpace(rest.front())) {
+        rest.remove_prefix(1);
+    }
+}
+
+// false with an error message, or true with an empty type for blank and comment lines
+bool parseLine(std::string_view rest, Line& line, std::string& error) {
+    while (line.indent < rest.size() && rest[line.indent] == ' ') {
+        ++line.indent;
+    }
+    rest.remove_prefix(line.indent);
+    // A tab has no width that both the author's editor and the nesting agree on
+    bool tabbed = !rest.empty() && rest.front() == '\t';
+    skipSpaces(rest);
+    if (rest.empty() || rest.front() == '#') {
+        return true;
+    }
+    if (tabbed) {
+        error = "tab in indentation, indent with spaces";
+        return false;
+    }
+
+    std::string token;
+    readToken(rest, line.type, error);
+    skipSpaces(rest);
+    if (!rest.empty() && rest.front() == '"') {
+        if (!readToken(rest, token, error)) {
+            return false;
+        }
+        line.text = token;
+    }
+    while (skipSpaces(rest), !rest.empty()) {
+        std::string name, value;
+        readToken(rest, name, error);
+        if (name.empty() || rest.empty() || rest.front() != '=') {
+            error = "expected name=value";
+            return false;
+        }
+        rest.remove_prefix(1);
+        if (!readToken(rest, value, error)) {
+            return false;
+        }
+        line.attributes.emplace_back(std::move(name), std::move(value));
+    }
+    return true;
+}
+
+// A size in pixels, 0 to LV_COORD_MAX
+bool parseCoord(const std::string& text, uint32_t& out) {
+    int32_t value = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc() || ptr != end || value < 0 || value > LV_COORD_MAX) {
+        return false;
+    }
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+bool parseColor(const std::string& text, uint32_t& out) {
+    if (text.size() != 7 || text[0] != '#') {
+        return false;
+    }
+    uint32_t rgb = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data() + 1, end, rgb, 16);
+    out = 0xFF000000u | rgb;
+    return ec == std::errc() && ptr == end;
+}
+
+bool typeOf(const std::string& name, DuiSnapshotType& type) {
+    static const std::pair<const char*, DuiSnapshotType> types[] = {
+        {"vstack", DuiSnapshotType::VStack}, {"hstack", DuiSnapshotType::HStack}, {"text", DuiSnapshotType::Text},
+        {"button", DuiSnapshotType::Button}, {"image", DuiSnapshotType::Image},
+    };
+    for (const auto& [typeName, value] : types) {
+        if (name == typeName) {
+            type = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Writes one parsed line as a node; parent is already set on the writer
+bool emit(DuiSnapshotWriter& writer, const Line& line, DuiSnapshotType type, std::string& error) {
+    std::string key;
+    for (const auto& [name, value] : line.attributes) {
+        if (name == "key") {
+            key = value;
+        }
+    }
+    bool hasText = type == DuiSnapshotType::Text || type == DuiSnapshotType::Button || type == DuiSnapshotType::Image;
+    if (line.text && !hasText) {
+        error = line.type + " takes no text";
+        return false;
+    }
+    writer.add(type, key);
+    if (hasText) {
+        writer.stringProperty(type == DuiSnapshotType::Image ? DuiSnapshotProperty::Source : DuiSnapshotProperty::Text,
+                              line.text.value_or(""));
+    }
+
+    for (const auto& [name, value] : line.attributes) {
+        uint32_t number = 0;
+        if (name == "key") {
+            continue;
+        } else if (name == "width" || name == "height") {
+            if (!parseCoord(value, number)) {
+                error = "invalid " + name + " '" + value + "', expected 0 to " + std::to_string(LV_COORD_MAX);
+                return false;
+            }
+            writer.property(name == "width" ? DuiSnapshotProperty::Width : DuiSnapshotProperty::Height, number);
+        } else if (name == "bg" && type == DuiSnapshotType::Button) {
+            if (!parseColor(value, number)) {
+                error = "invalid color '" + value + "', expected #RRGGBB";
+                return false;
+            }
+            writer.property(DuiSnapshotProperty::BgColor, number);
+        } else if (name == "onClick" && type == DuiSnapshotType::Button) {
+            writer.callback(DuiSnapshotProperty::OnClick, value);
+        } else {
+            error = "unknown attribute '" + name + "' for " + line.type;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: dui_layoutc input.dui output.snap" << std::endl;
+        return 2;
+    }
+    std::ifstream input(argv[1]);
+    if (!input) {
+        std::cerr << argv[1] << ": cannot open" << std::endl;
+        return 1;
+    }
+
+    DuiSnapshotWriter writer;
+    // Ancestors of the current line
+    std::vector<Open> open;
+    std::string text;
+    for (int number = 1; std::getline(input, text); ++number) {
+        Line line;
+        std::string error;
+        DuiSnapshotType type = DuiSnapshotType::Object;
+        bool ok = parseLine(text, line, error);
+        if (ok && line.type.empty()) {
+            continue;
+        }
+        if (ok && !typeOf(line.type, type)) {
+            error = "unknown view '" + line.type + "'";
+            ok = false;
+        }
+        while (ok && !open.empty() && open.back().indent >= line.indent) {
+            open.pop_back();
+        }
+        if (ok && open.empty() && writer.nodeCount()) {
+            error = "a layout has one root view";
+            ok = false;
+        }
+        if (ok && !open.empty() && open.back().type != DuiSnapshotType::VStack &&
+            open.back().type != DuiSnapshotType::HStack) {
+            error = "only vstack and hstack have children";
+            ok = false;
+        }
+        if (ok) {
+            writer.setParent(open.empty() ? DuiSnapshotNode::NoParent : open.back().node);
+            open.push_back({line.indent, static_cast<uint32_t>(writer.nodeCount()), type});
+            ok = emit(writer, line, type, error);
+        }
+        if (!ok) {
+            std::cerr << argv[1] << ":" << number << ": " << error << std::endl;
+            return 1;
+        }
+    }
+    if (!writer.nodeCount()) {
+        std::cerr << argv[1] << ": no views" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> data = writer.finish();
+    if (!DuiSnapshot::save(data, argv[2])) {
+        std::cerr << argv[2] << ": cannot write" << std::endl;
+        std::remove(argv[2]);
+        return 1;
+    }
+    std::cout << argv[2] << ": " << writer.nodeCount() << " views, " << data.size() << " bytes" << std::endl;
+    return 0;
+}
@@ -6,15 +6,16 @@
 /*********************
  *      INCLUDES
  *********************/
-#define _DEFAULT_SOURCE /* needed for usleep() */
 #include <stdlib.h>
-#include <unistd.h>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include "lvgl/lvgl.h"
 #include "lvgl/examples/lv_examples.h"
 #include "lvgl/demos/lv_demos.h"
 
+#include "LVGLApplication.h"
 #include "components/iface/Button.h"
 #include "components/iface/Label.h"
 #include "components/iface/Container.h"
@@ -31,7 +32,6 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static lv_display_t * hal_init(int32_t w, int32_t h);
 
 /**********************
  *  STATIC VARIABLES
@@ -65,160 +65,63 @@ static lv_display_t * hal_init(int32_t w, int32_t h);
  *   GLOBAL FUNCTIONS
  **********************/
 
-/**
- * @brief LVGL Application class
- * 
- * This class provides a C++ wrapper around the LVGL functionality
- */
-class LVGLApplication {
-private:
-    lv_display_t* display_;
-    bool initialized_;
-    
-public:
-    /**
-     * @brief Constructor
-     */
-    LVGLApplication() : display_(NULL), initialized_(false) {
-        std::cout << "LVGL Application initializing..." << std::endl;
-    }
-    
-    /**
-     * @brief Destructor
-     */
-    ~LVGLApplication() {
-        cleanup();
-    }
-    
-    /**
-     * @brief Initialize the LVGL application
-     * @param width Display width
-     * @param height Display height
-     * @return true if initialization successful, false otherwise
-     */
-    bool initialize(int32_t width, int32_t height) {
-        if (initialized_) {
-            std::cerr << "LVGL already initialized!" << std::endl;
-            return false;
-        }
-        
-        try {
-            // Initialize LVGL
-            lv_init();
-            
-            // Initialize the display and input devices
-            display_ = hal_init(width, height);
-            if (!display_) {
-                std::cerr << "Failed to initialize display!" << std::endl;
-                return false;
-            }
-            
-            initialized_ = true;
-            std::cout << "LVGL Application initialized successfully" << std::endl;
-            return true;
-        } catch (const std::exception& e) {
-            std::cerr << "Exception during initialization: " << e.what() << std::endl;
-            return false;
-        }
-    }
-    
-    /**
-     * @brief Run the demo with specified arguments
-     * @param argc Number of arguments
-     * @param argv Argument array
-     * @return true if demo started successfully, false otherwise
-     */
-    bool runDemo(int argc, char** argv) {
-        if (!initialized_) {
-            std::cerr << "LVGL not initialized!" << std::endl;
-            return false;
-        }
-        
-        try {
-            // Open a demo or an example
-            if (argc == 0) {
-                lv_demo_widgets();
-                // lv_example_chart_1();
-            } else {
-                if (!lv_demos_create(&argv[1], argc - 1)) {
-                    lv_demos_show_help();
-                    return false;
-                }
-            }
-            
-            return true;
-        } catch (const std::exception& e) {
-            std::cerr << "Exception during demo execution: " << e.what() << std::endl;
-            return false;
-        }
-    }
-    
-    /**
-     * @brief Main application loop
-     */
-    void run() {
-        if (!initialized_) {
-            std::cerr << "LVGL not initialized!" << std::endl;
-            return;
-        }
-        
-        std::cout << "Starting main loop..." << std::endl;
-        
-        try {
-            while (true) {
-                // Periodically call the lv_task handler.
-                // It could be done in a timer interrupt or an OS task too.
-                lv_timer_handler();
-                usleep(10 * 1000);
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Exception in main loop: " << e.what() << std::endl;
-        }
-    }
-    
-    /**
-     * @brief Cleanup resources
-     */
-    void cleanup() {
-        if (initialized_) {
-            std::cout << "Cleaning up LVGL..." << std::endl;
-            lv_deinit();
-            initialized_ = false;
-            display_ = NULL;
-        }
-    }
-    
-    /**
-     * @brief Get display pointer
-     * @return Display pointer or NULL if not initialized
-     */
-    lv_display_t* getDisplay() const {
-        return display_;
-    }
-    
-    /**
-     * @brief Check if application is initialized
-     * @return true if initialized, false otherwise
-     */
-    bool isInitialized() const {
-        return initialized_;
-    }
-};
-
 int main(int argc, char **argv)
 {
-    (void)argc; /*Unused*/
-    (void)argv; /*Unused*/
 
     try {
+        // Command line: --draw-units N limits the render threads,
+        // --loop-stats reports idle CPU use and input latency,
+        // --headless N renders N frames in memory and prints the frame stats,
+        // --frame-report FILE writes frame time percentiles as JSON on exit,
+        // --render-mode partial|direct|full, --buffers 1|2, --buffer-lines N and
+        // --color-format native|rgb565|rgb888 choose the SDL display's buffering
+        const char* frameReport = NULL;
+        DisplayConfig display;
+        uint32_t drawUnits = 0;
+        bool loopStats = false;
+        uint32_t headlessFrames = 0;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--draw-units") == 0 && i + 1 < argc) {
+                drawUnits = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 10));
+            } else if (std::strcmp(argv[i], "--loop-stats") == 0) {
+                loopStats = true;
+            } else if (std::strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+                headlessFrames = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 10));
+            } else if (std::strcmp(argv[i], "--frame-report") == 0 && i + 1 < argc) {
+                frameReport = argv[++i];
+            } else if (std::strcmp(argv[i], "--render-mode") == 0 && i + 1 < argc) {
+                const char* mode = argv[++i];
+                display.renderMode = std::strcmp(mode, "partial") == 0 ? LV_DISPLAY_RENDER_MODE_PARTIAL
+                                   : std::strcmp(mode, "full") == 0    ? LV_DISPLAY_RENDER_MODE_FULL
+                                                                       : LV_DISPLAY_RENDER_MODE_DIRECT;
+            } else if (std::strcmp(argv[i], "--buffers") == 0 && i + 1 < argc) {
+                display.bufferCount = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 10));
+            } else if (std::strcmp(argv[i], "--buffer-lines") == 0 && i + 1 < argc) {
+                display.bufferLines = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 10));
+            } else if (std::strcmp(argv[i], "--color-format") == 0 && i + 1 < argc) {
+                const char* format = argv[++i];
+                display.colorFormat = std::strcmp(format, "rgb565") == 0 ? LV_COLOR_FORMAT_RGB565
+                                    : std::strcmp(format, "rgb888") == 0 ? LV_COLOR_FORMAT_RGB888
+                                                                         : LV_COLOR_FORMAT_NATIVE;
+            }
+        }
+
         // Create LVGL application instance
         LVGLApplication app;
         
         // Initialize the application
-        if (!app.initialize(480, 320)) {
+        HeadlessConfig headless;
+        headless.width = 480;
+        headless.height = 320;
+        bool initialized = headlessFrames ? app.initializeHeadless(headless, drawUnits)
+                                          : app.initialize(display, drawUnits);
+        if (!initialized) {
             std::cerr << "Failed to initialize LVGL application" << std::endl;
             return -1;
         }
+        if (frameReport) {
+            app.setFrameReport(frameReport);
+        }
 
         // 设置黑色主题背景
         lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(Gui::ColorConfig::Black), LV_PART_MAIN);
@@ -249,7 +152,22 @@ int main(int argc, char **argv)
         //     return -1;
         // }
         
+        if (headlessFrames) {
+            // Every frame redraws the whole screen, so the counters measure rendering rather than idling
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < headlessFrames; ++i) {
+                lv_obj_invalidate(lv_screen_active());
+                app.renderFrame();
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            app.printFrameStats(elapsed.count());
+            return 0;
+        }
+
         // Start the main loop
+        if (loopStats) {
+            app.setStatsInterval(5000);
+        }
         app.run();
         
     } catch (const std::exception& e) {
@@ -262,38 +180,3 @@ int main(int argc, char **argv)
     
     return 0;
 }
-
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
-/**
- * Initialize the Hardware Abstraction Layer (HAL) for the LVGL graphics
- * library
- */
-static lv_display_t * hal_init(int32_t w, int32_t h)
-{
-  lv_group_set_default(lv_group_create());
-
-  lv_display_t * disp = lv_sdl_window_create(w, h);
-
-  lv_indev_t * mouse = lv_sdl_mouse_create();
-  lv_indev_set_group(mouse, lv_group_get_default());
-  lv_indev_set_display(mouse, disp);
-  lv_display_set_default(disp);
-
-  LV_IMAGE_DECLARE(mouse_cursor_icon); /*Declare the image file.*/
-  lv_obj_t * cursor_obj;
-  cursor_obj = lv_image_create(lv_screen_active()); /*Create an image object for the cursor */
-  lv_image_set_src(cursor_obj, &mouse_cursor_icon);           /*Set the image source*/
-  lv_indev_set_cursor(mouse, cursor_obj);             /*Connect the image  object to the driver*/
-
-  lv_indev_t * mousewheel = lv_sdl_mousewheel_create();
-  lv_indev_set_display(mousewheel, disp);
-
-  lv_indev_t * keyboard = lv_sdl_keyboard_create();
-  lv_indev_set_display(keyboard, disp);
-  lv_indev_set_group(keyboard, lv_group_get_default());
-
-  return disp;
-}